@@ -0,0 +1,10 @@
+#ifndef META_CONFIG_HPP
+#define META_CONFIG_HPP
+
+
+#ifndef META_LOOKUP_CACHE_SIZE
+#define META_LOOKUP_CACHE_SIZE 0
+#endif // META_LOOKUP_CACHE_SIZE
+
+
+#endif // META_CONFIG_HPP
@@ -0,0 +1,317 @@
+#ifndef META_DELTA_HPP
+#define META_DELTA_HPP
+
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include "meta.hpp"
+#include "serializer.hpp"
+
+
+namespace meta {
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+struct delta_codec {
+    using size_type = std::size_t;
+
+    static layout_cache & cache() {
+        thread_local layout_cache instance{};
+        return instance;
+    }
+
+    static size_type mask(const layout_plan &plan) noexcept {
+        return (plan.fields.size() + 7u) / 8u;
+    }
+
+    static std::byte * segment(const layout_plan::segment &segment, void *instance) {
+        auto *ptr = static_cast<std::byte *>(instance);
+
+        for(auto *base: segment.path) {
+            ptr = static_cast<std::byte *>(base->cast(ptr));
+        }
+
+        return ptr;
+    }
+
+    static void * member(const layout_plan::segment &segment, const layout_plan::step &target, std::byte *ptr, any &value) {
+        if(target.data->address) {
+            return ptr + target.offset;
+        }
+
+        handle parent{};
+        parent.node = segment.parent;
+        parent.instance = ptr;
+        value = target.data->get(parent, {});
+
+        return handle{value}.instance;
+    }
+
+    static bool same(const type_node *type, void *lhs, void *rhs) {
+        if(type->unique) {
+            return std::memcmp(lhs, rhs, type->size) == 0;
+        } else if(const auto &plan = cache().plan(type); plan.valid) {
+            // paddings aren't part of the value, reflected members are compared one by one
+            for(auto &&field: plan.fields) {
+                const auto &curr = plan.segments[field.segment];
+                any lvalue{};
+                any rvalue{};
+                auto *source = member(curr, field.target, segment(curr, lhs), lvalue);
+                auto *target = member(curr, field.target, segment(curr, rhs), rvalue);
+
+                if(!source || !target || !same(field.target.type, source, target)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        return type->compare(lhs, rhs);
+    }
+
+    static bool diff(const layout_plan &plan, void *from, void *to, std::vector<std::byte> &out) {
+        const auto first = out.size();
+        out.resize(first + mask(plan));
+
+        std::byte *lhs{};
+        std::byte *rhs{};
+
+        for(size_type pos{}, last = plan.segments.size(); pos < plan.fields.size(); ++pos) {
+            const auto &field = plan.fields[pos];
+            const auto &curr = plan.segments[field.segment];
+
+            if(field.segment != last) {
+                // fields are sorted by segment, bases are walked once per segment
+                lhs = segment(curr, from);
+                rhs = segment(curr, to);
+                last = field.segment;
+            }
+
+            any lvalue{};
+            any rvalue{};
+            auto *source = member(curr, field.target, lhs, lvalue);
+            auto *target = member(curr, field.target, rhs, rvalue);
+            bool changed{};
+
+            if(!source || !target) {
+                return false;
+            } else if(field.target.size) {
+                if((changed = !same(field.target.type, source, target))) {
+                    const auto *bytes = static_cast<const std::byte *>(target);
+                    out.insert(out.end(), bytes, bytes + field.target.size);
+                }
+            } else if(!field.target.type->compare(source, target)) {
+                // types without an equality operator are compared by address, members are walked anyway
+                const auto &nested = cache().plan(field.target.type);
+                const auto offset = out.size();
+
+                if(!diff(nested, source, target, out)) {
+                    return false;
+                }
+
+                const auto *bits = out.data() + offset;
+
+                if(!(changed = std::any_of(bits, bits + mask(nested), [](const auto bit) { return bit != std::byte{}; }))) {
+                    out.resize(offset);
+                }
+            }
+
+            if(changed) {
+                out[first + pos / 8u] |= std::byte{1u} << (pos % 8u);
+            }
+        }
+
+        return true;
+    }
+
+    // walks a delta without applying it, to reject truncated ones before writing anything
+    static bool measure(const layout_plan &plan, const std::byte *&curr, const std::byte *last) {
+        const auto size = mask(plan);
+
+        if(static_cast<size_type>(last - curr) < size) {
+            return false;
+        }
+
+        const auto *bits = curr;
+        curr += size;
+
+        for(size_type pos{}; pos < plan.fields.size(); ++pos) {
+            if((bits[pos / 8u] & (std::byte{1u} << (pos % 8u))) != std::byte{}) {
+                const auto &field = plan.fields[pos];
+
+                if(field.target.size) {
+                    if(static_cast<size_type>(last - curr) < field.target.size) {
+                        return false;
+                    }
+
+                    curr += field.target.size;
+                } else if(!measure(cache().plan(field.target.type), curr, last)) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static bool patch(const layout_plan &plan, void *instance, const std::byte *&curr, const std::byte *last) {
+        const auto size = mask(plan);
+
+        if(static_cast<size_type>(last - curr) < size) {
+            return false;
+        }
+
+        const auto *bits = curr;
+        curr += size;
+
+        for(size_type pos{}; pos < plan.fields.size(); ++pos) {
+            if((bits[pos / 8u] & (std::byte{1u} << (pos % 8u))) != std::byte{}) {
+                const auto &field = plan.fields[pos];
+                const auto &parent = plan.segments[field.segment];
+                auto *ptr = segment(parent, instance);
+                any value{};
+                void *elem = member(parent, field.target, ptr, value);
+
+                if(!elem) {
+                    return false;
+                } else if(field.target.size) {
+                    if(static_cast<size_type>(last - curr) < field.target.size) {
+                        return false;
+                    }
+
+                    std::memcpy(elem, curr, field.target.size);
+                    curr += field.target.size;
+                } else if(!patch(cache().plan(field.target.type), elem, curr, last)) {
+                    return false;
+                }
+
+                if(value) {
+                    handle owner{};
+                    owner.node = parent.parent;
+                    owner.instance = ptr;
+
+                    if(!field.target.data->set(owner, {}, std::move(value))) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static std::vector<std::byte> diff(const meta::type &type, handle from, handle to) {
+        std::vector<std::byte> out{};
+
+        if(type && from.node == type.node && to.node == type.node && from && to) {
+            if(const auto &plan = cache().plan(type.node); plan.valid) {
+                const auto *bytes = reinterpret_cast<const std::byte *>(&plan.schema);
+                out.insert(out.end(), bytes, bytes + sizeof(plan.schema));
+
+                if(!diff(plan, from.instance, to.instance, out)) {
+                    out.clear();
+                }
+            }
+        }
+
+        return out;
+    }
+
+    static bool patch(const meta::type &type, handle instance, const std::byte *data, const size_type size) {
+        if(type && instance.node == type.node && instance && data && size >= sizeof(std::size_t)) {
+            if(const auto &plan = cache().plan(type.node); plan.valid) {
+                std::size_t schema{};
+                std::memcpy(&schema, data, sizeof(schema));
+
+                const auto *probe = data + sizeof(schema);
+                const auto *curr = probe;
+
+                return schema == plan.schema
+                    && measure(plan, probe, data + size) && probe == data + size
+                    && patch(plan, instance.instance, curr, data + size);
+            }
+        }
+
+        return false;
+    }
+};
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief Computes the changes between two instances of a reflected type.
+ *
+ * A delta is made of the schema hash of the type, followed by a bitmask with
+ * one bit for each member and the new values of the members that changed, in
+ * the same order in which a serializer writes them.<br/>
+ * Trivially copyable members are compared byte by byte when their types have
+ * no paddings, member by member when they are reflected and through their
+ * equality operators otherwise. Their new values are copied as they are.
+ * Other members are compared through their equality operators first, if any,
+ * and walked recursively only when they differ. In this case, the new value is
+ * in turn a bitmask followed by the values of the nested members that changed.
+ *
+ * Setter/getter pairs are the only members that go through meta any objects.
+ * Static and constant data members aren't part of a delta.<br/>
+ * Plans are compiled the first time a type is used and shared with the
+ * serializer machinery. They are cached per thread and invalidated whenever
+ * types are registered or unregistered.
+ *
+ * @param type The type of the instances to compare.
+ * @param from A handle to the old instance.
+ * @param to A handle to the new instance.
+ * @return The delta in case of success, an empty buffer if the instances
+ * aren't of the given type or the latter cannot be serialized.
+ */
+inline std::vector<std::byte> diff(const type &type, handle from, handle to) {
+    return internal::delta_codec::diff(type, from, to);
+}
+
+
+/**
+ * @brief Applies a delta to an instance of a reflected type.
+ *
+ * Only the members marked as changed are written. The delta must have been
+ * computed for the same schema, deltas aren't meant to be stored.
+ *
+ * Deltas are validated against the plan of the type before any member is
+ * written, truncated or oversized deltas leave the instance untouched.
+ *
+ * @warning
+ * The instance may be partially updated if a setter rejects its value.
+ *
+ * @param type The type of the instance to update.
+ * @param instance A handle to the instance to update.
+ * @param data A pointer to the delta to apply.
+ * @param size The size of the delta in bytes.
+ * @return True in case of success, false otherwise.
+ */
+inline bool patch(const type &type, handle instance, const std::byte *data, const std::size_t size) {
+    return internal::delta_codec::patch(type, instance, data, size);
+}
+
+
+}
+
+
+#endif // META_DELTA_HPP
@@ -4,11 +4,22 @@
 
 #include <tuple>
 #include <array>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
+#include <iterator>
+#include <typeinfo>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
 #include <functional>
 #include <type_traits>
+#include "hashed_string.hpp"
 #include "policy.hpp"
 #include "meta.hpp"
 
@@ -16,6 +27,61 @@
 namespace meta {
 
 
+/**
+ * @brief Compile-time description of a meta base.
+ * @tparam Base Type of the base class to assign to the meta type.
+ */
+template<typename Base>
+struct static_base {};
+
+
+/**
+ * @brief Compile-time description of a meta constructor.
+ * @tparam Args Types of arguments to use to construct an instance.
+ */
+template<typename... Args>
+struct static_ctor {};
+
+
+/**
+ * @brief Compile-time description of a meta data.
+ * @tparam Data The actual variable to attach to the meta type.
+ * @tparam Identifier Unique identifier.
+ * @tparam Policy Optional policy (no policy set by default).
+ */
+template<auto Data, std::size_t Identifier, typename Policy = as_is_t>
+struct static_data {};
+
+
+/**
+ * @brief Compile-time description of a meta function.
+ * @tparam Candidate The actual function to attach to the meta type.
+ * @tparam Identifier Unique identifier.
+ * @tparam Policy Optional policy (no policy set by default).
+ */
+template<auto Candidate, std::size_t Identifier, typename Policy = as_is_t>
+struct static_func {};
+
+
+/**
+ * @brief Compile-time descriptor of a meta type.
+ *
+ * The nodes of the parts listed by a descriptor are laid out as constant data
+ * and are already linked to each other at compile-time. Therefore, they don't
+ * require any dynamic initialization and registering a descriptor takes a
+ * constant time, no matter how many parts it has.<br/>
+ * Properties aren't supported by descriptors. Uniqueness of the identifiers of
+ * meta data and meta functions is checked at compile-time instead.
+ *
+ * @tparam Type Type to reflect.
+ * @tparam Identifier Unique identifier.
+ * @tparam Part Parts of the meta type, that is any combination of
+ * `static_base`, `static_ctor`, `static_data` and `static_func`.
+ */
+template<typename Type, std::size_t Identifier, typename... Part>
+struct descriptor {};
+
+
 /**
  * @cond TURN_OFF_DOXYGEN
  * Internal details not to be documented.
@@ -71,6 +137,458 @@ template<typename Candidate>
 using function_helper_t = decltype(to_function_helper(std::declval<Candidate>()));
 
 
+inline std::uint64_t mix(std::uint64_t value) noexcept {
+    value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27u)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31u);
+}
+
+
+inline frozen_node::hash perfect_hash(const std::size_t *identifier, const std::size_t count, std::vector<std::uint64_t> &pilot, std::vector<std::size_t> &slot) {
+    using size_type = std::size_t;
+    size_type bits = 1u;
+
+    while((size_type{1u} << bits) < (count + count / 4u)) {
+        ++bits;
+    }
+
+    // duplicate identifiers can't be told apart, lookups fall back to a linear scan if all attempts fail
+    for(const auto last = bits + 4u; count && bits < last; ++bits) {
+        const auto bucket_bits = bits > 1u ? bits - 1u : bits;
+        std::vector<std::vector<size_type>> bucket(size_type{1u} << bucket_bits);
+        std::vector<size_type> order(bucket.size());
+        std::vector<std::uint64_t> displacement(bucket.size());
+        std::vector<bool> used(size_type{1u} << bits);
+        bool done = true;
+
+        const auto to_slot = [bits](const std::uint64_t key, const std::uint64_t value) {
+            return static_cast<size_type>(((key ^ value) * frozen_node::slot_multiplier) >> (64u - bits));
+        };
+
+        for(size_type pos{}; pos < count; ++pos) {
+            bucket[(std::uint64_t{identifier[pos]} * frozen_node::bucket_multiplier) >> (64u - bucket_bits)].push_back(pos);
+        }
+
+        for(size_type pos{}; pos < order.size(); ++pos) {
+            order[pos] = pos;
+        }
+
+        // larger buckets are harder to place, they go first
+        std::stable_sort(order.begin(), order.end(), [&bucket](const auto lhs, const auto rhs) {
+            return bucket[lhs].size() > bucket[rhs].size();
+        });
+
+        for(auto it = order.cbegin(), end = order.cend(); done && it != end && !bucket[*it].empty(); ++it) {
+            const auto &keys = bucket[*it];
+            done = false;
+
+            for(std::uint64_t attempt{}; !done && attempt < 4096u; ++attempt) {
+                const auto value = mix(attempt + 1u);
+                size_type placed{};
+
+                while(placed < keys.size() && !used[to_slot(identifier[keys[placed]], value)]) {
+                    used[to_slot(identifier[keys[placed++]], value)] = true;
+                }
+
+                if(placed == keys.size()) {
+                    displacement[*it] = value;
+                    done = true;
+                } else {
+                    while(placed) {
+                        used[to_slot(identifier[keys[--placed]], value)] = false;
+                    }
+                }
+            }
+        }
+
+        if(done) {
+            const frozen_node::hash params{64u - bucket_bits, 64u - bits, pilot.size(), slot.size()};
+            pilot.insert(pilot.end(), displacement.cbegin(), displacement.cend());
+            slot.resize(slot.size() + used.size());
+
+            for(size_type pos{}; pos < count; ++pos) {
+                slot[params.slot + to_slot(identifier[pos], displacement[(std::uint64_t{identifier[pos]} * frozen_node::bucket_multiplier) >> params.bucket_shift])] = pos;
+            }
+
+            return params;
+        }
+    }
+
+    return {};
+}
+
+
+// same order of internal::find, the functions of a type shadow those of its bases
+inline void flatten(const type_node *node, std::vector<std::pair<std::size_t, const func_node *>> &row) {
+    for(internal::func_node *curr = node->func; curr; curr = curr->next) {
+        const auto slot = slot_node::intern(curr->identifier);
+
+        if(std::find_if(row.cbegin(), row.cend(), [slot](const auto &elem) { return elem.first == slot; }) == row.cend()) {
+            row.emplace_back(slot, curr);
+        }
+    }
+
+    for(internal::base_node *curr = node->base; curr; curr = curr->next) {
+        flatten(curr->type, row);
+    }
+}
+
+
+// members of a type followed by those of its bases, in the same order as the regular walk
+template<auto Member, typename Node>
+void linearize(const type_node *node, std::vector<const type_node *> &visited, std::vector<const Node *> &flat) {
+    for(const Node *curr = node->*Member; curr; curr = curr->next) {
+        flat.push_back(curr);
+    }
+
+    for(internal::base_node *curr = node->base; curr; curr = curr->next) {
+        if(std::find(visited.cbegin(), visited.cend(), curr->type) == visited.cend()) {
+            visited.push_back(curr->type);
+            linearize<Member>(curr->type, visited, flat);
+        }
+    }
+}
+
+
+inline void compact(context_node &ctx) {
+    using size_type = frozen_node::size_type;
+    std::vector<size_type> type_identifier, data_range, data_identifier, func_range, func_identifier, slot;
+    std::vector<frozen_node::hash> data_hash, func_hash;
+    std::vector<std::uint64_t> pilot;
+    std::unordered_map<const type_node *, size_type> position;
+
+    for(internal::type_node *curr = ctx.type; curr; curr = curr->next) {
+        position.emplace(curr, type_identifier.size());
+        type_identifier.push_back(curr->identifier);
+        data_range.push_back(data_identifier.size());
+        func_range.push_back(func_identifier.size());
+        iterate([&data_identifier](auto *node) { data_identifier.push_back(node->identifier); }, curr->data);
+        iterate([&func_identifier](auto *node) { func_identifier.push_back(node->identifier); }, curr->func);
+        data_hash.push_back(perfect_hash(data_identifier.data() + data_range.back(), data_identifier.size() - data_range.back(), pilot, slot));
+        func_hash.push_back(perfect_hash(func_identifier.data() + func_range.back(), func_identifier.size() - func_range.back(), pilot, slot));
+    }
+
+    const auto type_hash = perfect_hash(type_identifier.data(), type_identifier.size(), pilot, slot);
+    const auto types = type_identifier.size();
+    std::vector<size_type> base_index(types, types);
+    std::vector<std::pair<size_type, size_type>> derived;
+    std::vector<bool> closed(types, true);
+    size_type columns{};
+
+    for(internal::type_node *curr = ctx.type; curr; curr = curr->next) {
+        const auto row = position[curr];
+        std::vector<const type_node *> pending{curr}, visited{};
+
+        // transitive closure of the bases, it's complete only if they all belong to the arena
+        while(!pending.empty()) {
+            const auto *node = pending.back();
+            pending.pop_back();
+            closed[row] = closed[row] && !node->pending.load(std::memory_order_relaxed);
+
+            for(internal::base_node *base = node->base; base; base = base->next) {
+                if(std::find(visited.cbegin(), visited.cend(), base->type) == visited.cend()) {
+                    const auto it = position.find(base->type);
+                    visited.push_back(base->type);
+                    pending.push_back(base->type);
+
+                    if(it == position.cend()) {
+                        closed[row] = false;
+                    } else {
+                        base_index[it->second] = (base_index[it->second] == types) ? columns++ : base_index[it->second];
+                        derived.emplace_back(row, base_index[it->second]);
+                    }
+                }
+            }
+        }
+    }
+
+    const auto base_words = (columns + 63u) / 64u;
+    std::vector<std::uint64_t> bases(types * base_words);
+
+    for(auto [row, column]: derived) {
+        bases[row * base_words + column / 64u] |= std::uint64_t{1u} << (column % 64u);
+    }
+
+    std::vector<std::vector<std::pair<size_type, const func_node *>>> functions(types);
+    std::vector<size_type> order(types), dispatch_offset(types);
+    std::vector<frozen_node::entry> dispatch;
+
+    std::vector<size_type> flat_data_range(types + 1u), flat_func_range(types + 1u);
+    std::vector<const data_node *> flat_data;
+    std::vector<const func_node *> flat_func;
+
+    for(internal::type_node *curr = ctx.type; curr; curr = curr->next) {
+        if(const auto row = position[curr]; closed[row]) {
+            flatten(curr, functions[row]);
+        }
+    }
+
+    for(internal::type_node *curr = ctx.type; curr; curr = curr->next) {
+        const auto row = position[curr];
+        std::vector<const type_node *> visited{};
+        flat_data_range[row] = flat_data.size();
+        flat_func_range[row] = flat_func.size();
+
+        if(closed[row]) {
+            linearize<&type_node::data>(curr, visited, flat_data);
+            visited.clear();
+            linearize<&type_node::func>(curr, visited, flat_func);
+        }
+    }
+
+    flat_data_range[types] = flat_data.size();
+    flat_func_range[types] = flat_func.size();
+
+    for(size_type row{}; row < types; ++row) {
+        order[row] = row;
+    }
+
+    std::sort(order.begin(), order.end(), [&functions](const auto lhs, const auto rhs) {
+        return functions[lhs].size() > functions[rhs].size();
+    });
+
+    size_type first_free{};
+
+    // rows are overlapped at the first offset where their slots are all free (row displacement)
+    for(const auto row: order) {
+        const auto lowest = functions[row].empty() ? size_type{} : std::min_element(functions[row].cbegin(), functions[row].cend())->first;
+        size_type offset = (first_free > lowest) ? (first_free - lowest) : size_type{};
+
+        const auto collide = [&dispatch, &functions, row](const size_type candidate) {
+            return std::any_of(functions[row].cbegin(), functions[row].cend(), [&dispatch, candidate](const auto &elem) {
+                return candidate + elem.first < dispatch.size() && dispatch[candidate + elem.first].func;
+            });
+        };
+
+        while(!functions[row].empty() && collide(offset)) {
+            ++offset;
+        }
+
+        for(auto [slot, func]: functions[row]) {
+            dispatch.resize(std::max(dispatch.size(), offset + slot + 1u), frozen_node::entry{types, nullptr});
+            dispatch[offset + slot] = { row, func };
+        }
+
+        dispatch_offset[row] = offset;
+
+        while(first_free < dispatch.size() && dispatch[first_free].func) {
+            ++first_free;
+        }
+    }
+
+    const auto data = data_identifier.size();
+    const auto func = func_identifier.size();
+    data_range.push_back(data);
+    func_range.push_back(func);
+    size_type bytes{};
+
+    const auto reserve = [&bytes](const size_type count, const size_type size) {
+        const auto offset = bytes;
+        bytes += (count * size + frozen_node::alignment - 1u) / frozen_node::alignment * frozen_node::alignment;
+        return offset;
+    };
+
+    // every array starts on its own cache line
+    const size_type offset[] = {
+        reserve(types, sizeof(size_type)),
+        reserve(types, sizeof(type_node *)),
+        reserve(types, sizeof(frozen_node::record)),
+        reserve(types + 1u, sizeof(size_type)),
+        reserve(types, sizeof(frozen_node::hash)),
+        reserve(data, sizeof(size_type)),
+        reserve(data, sizeof(data_node *)),
+        reserve(types + 1u, sizeof(size_type)),
+        reserve(types, sizeof(frozen_node::hash)),
+        reserve(func, sizeof(size_type)),
+        reserve(func, sizeof(func_node *)),
+        reserve(pilot.size(), sizeof(std::uint64_t)),
+        reserve(slot.size(), sizeof(size_type)),
+        reserve(types, sizeof(size_type)),
+        reserve(types, sizeof(bool)),
+        reserve(bases.size(), sizeof(std::uint64_t)),
+        reserve(types, sizeof(size_type)),
+        reserve(dispatch.size(), sizeof(frozen_node::entry)),
+        reserve(types + 1u, sizeof(size_type)),
+        reserve(flat_data.size(), sizeof(data_node *)),
+        reserve(types + 1u, sizeof(size_type)),
+        reserve(flat_func.size(), sizeof(func_node *))
+    };
+
+    auto arena = std::make_unique<frozen_node>(bytes);
+    auto *storage = static_cast<std::byte *>(arena->storage);
+
+    const auto locate = [storage, &offset](auto *&array, const size_type index) {
+        array = static_cast<std::remove_reference_t<decltype(array)>>(static_cast<void *>(storage + offset[index]));
+        return array;
+    };
+
+    arena->size = types;
+    arena->type_hash = type_hash;
+    std::copy(type_identifier.cbegin(), type_identifier.cend(), locate(arena->type_identifier, 0u));
+    locate(arena->type, 1u);
+    locate(arena->records, 2u);
+    std::copy(data_range.cbegin(), data_range.cend(), locate(arena->data_range, 3u));
+    std::copy(data_hash.cbegin(), data_hash.cend(), locate(arena->data_hash, 4u));
+    std::copy(data_identifier.cbegin(), data_identifier.cend(), locate(arena->data_identifier, 5u));
+    locate(arena->data, 6u);
+    std::copy(func_range.cbegin(), func_range.cend(), locate(arena->func_range, 7u));
+    std::copy(func_hash.cbegin(), func_hash.cend(), locate(arena->func_hash, 8u));
+    std::copy(func_identifier.cbegin(), func_identifier.cend(), locate(arena->func_identifier, 9u));
+    locate(arena->func, 10u);
+    std::copy(pilot.cbegin(), pilot.cend(), locate(arena->pilot, 11u));
+    std::copy(slot.cbegin(), slot.cend(), locate(arena->slot, 12u));
+    arena->base_words = base_words;
+    std::copy(base_index.cbegin(), base_index.cend(), locate(arena->base_index, 13u));
+    std::copy(closed.cbegin(), closed.cend(), locate(arena->closed, 14u));
+    std::copy(bases.cbegin(), bases.cend(), locate(arena->bases, 15u));
+    arena->dispatch_size = dispatch.size();
+    std::copy(dispatch_offset.cbegin(), dispatch_offset.cend(), locate(arena->dispatch_offset, 16u));
+    std::copy(dispatch.cbegin(), dispatch.cend(), locate(arena->dispatch, 17u));
+    std::copy(flat_data_range.cbegin(), flat_data_range.cend(), locate(arena->flat_data_range, 18u));
+    std::copy(flat_data.cbegin(), flat_data.cend(), locate(arena->flat_data, 19u));
+    std::copy(flat_func_range.cbegin(), flat_func_range.cend(), locate(arena->flat_func_range, 20u));
+    std::copy(flat_func.cbegin(), flat_func.cend(), locate(arena->flat_func, 21u));
+
+    size_type pos{};
+
+    for(internal::type_node *curr = ctx.type; curr; curr = curr->next, ++pos) {
+        arena->type[pos] = curr;
+        arena->records[pos] = { arena.get(), pos };
+        iterate([&arena, next = data_range[pos]](auto *node) mutable { arena->data[next++] = node; }, curr->data);
+        iterate([&arena, next = func_range[pos]](auto *node) mutable { arena->func[next++] = node; }, curr->func);
+    }
+
+    for(pos = {}; pos < types; ++pos) {
+        arena->type[pos]->frozen.store(arena->records + pos, std::memory_order_release);
+    }
+
+    // readers can still walk the previous arena, it's released once they are done
+    if(std::unique_ptr<frozen_node> prev{ctx.frozen.exchange(arena.release(), std::memory_order_acq_rel)}; prev) {
+        prev->retired = std::move(ctx.retired);
+        ctx.retired = std::move(prev);
+    }
+}
+
+
+inline void freeze(context_node &ctx) {
+    // deferred types are realized first, the arena would be incomplete otherwise
+    for(internal::type_node *curr = ctx.type; curr; curr = curr->next) {
+        realize(curr);
+    }
+
+    compact(ctx);
+    epoch::synchronize();
+    ctx.retired.reset();
+}
+
+
+template<typename Op>
+void iterate(Op op, const context_node &ctx) noexcept {
+    if(const auto *arena = ctx.frozen.load(std::memory_order_acquire); arena) {
+        for(auto pos = 0u; pos < arena->size; ++pos) {
+            op(arena->type[pos]);
+        }
+    } else {
+        iterate(op, ctx.type);
+    }
+}
+
+
+template<typename Member>
+constexpr std::size_t tag_kind() noexcept {
+    if constexpr(std::is_same_v<Member, meta::type>) {
+        return 0u;
+    } else if constexpr(std::is_same_v<Member, meta::data>) {
+        return 1u;
+    } else if constexpr(std::is_same_v<Member, meta::func>) {
+        return 2u;
+    } else {
+        static_assert(std::is_same_v<Member, meta::ctor>);
+        return 3u;
+    }
+}
+
+
+inline bool same_key(const prop_node *lhs, const prop_node *rhs) noexcept {
+    return lhs->key_type == rhs->key_type && lhs->key_type->compare(lhs->key_data, rhs->key_data);
+}
+
+
+template<typename Member>
+void tag(context_node &ctx, prop_node &node, Member(* owner)() noexcept) {
+    std::lock_guard guard{ctx.tag_mutex};
+    auto &lists = ctx.tags[tag_kind<Member>()][node.key_hash];
+    const auto it = std::find_if(lists.begin(), lists.end(), [&node](const auto *head) { return same_key(head, &node); });
+
+    node.owner = reinterpret_cast<void(*)()>(owner);
+    node.ctx = &ctx;
+
+    if(it == lists.end()) {
+        node.tag = nullptr;
+        lists.push_back(&node);
+    } else {
+        // readers that already got the list keep walking it from the previous head
+        node.tag = *it;
+        *it = &node;
+    }
+}
+
+
+template<typename Member>
+void untag(prop_node &node) {
+    if(auto *ctx = node.ctx; ctx) {
+        std::lock_guard guard{ctx->tag_mutex};
+        auto &index = ctx->tags[tag_kind<Member>()];
+        auto &lists = index[node.key_hash];
+
+        for(auto it = lists.begin(); it != lists.end(); ++it) {
+            if(same_key(*it, &node)) {
+                // readers can still walk the detached property, it's reset later
+                if(*it == &node) {
+                    *it = node.tag;
+                } else {
+                    prop_node *curr = *it;
+
+                    while(curr->tag != &node) {
+                        curr = curr->tag;
+                    }
+
+                    curr->tag = node.tag;
+                }
+
+                if(!*it) {
+                    lists.erase(it);
+                }
+
+                break;
+            }
+        }
+
+        if(lists.empty()) {
+            index.erase(node.key_hash);
+        }
+
+        node.ctx = nullptr;
+    }
+}
+
+
+inline meta::type resolve(const context_node &ctx, const std::size_t identifier) noexcept {
+    const auto *curr = lookup_cache::find<&context_node::type>(&ctx, identifier, [&ctx, identifier]() -> const type_node * {
+        if(const auto *arena = ctx.frozen.load(std::memory_order_acquire); arena) {
+            const auto pos = arena->lookup(arena->type_hash, arena->type_identifier, arena->size, identifier);
+            return (pos == arena->size) ? nullptr : arena->type[pos];
+        }
+
+        return find_if([identifier](auto *node) {
+            return node->identifier == identifier;
+        }, ctx.type);
+    });
+
+    return curr ? realize(curr)->clazz() : meta::type{};
+}
+
+
 template<typename Type, typename... Args, std::size_t... Indexes>
 any construct(any * const args, std::index_sequence<Indexes...>) {
     [[maybe_unused]] auto direct = std::make_tuple((args+Indexes)->try_cast<Args>()...);
@@ -226,127 +744,660 @@ any invoke([[maybe_unused]] handle handle, any *args, std::index_sequence<Indexe
 }
 
 
+template<typename Type, typename Base>
+constexpr auto downcast_of() noexcept
+-> void *(*)(void *) noexcept {
+    if constexpr(std::is_polymorphic_v<Base>) {
+        return [](void *instance) noexcept -> void * {
+            return dynamic_cast<Type *>(static_cast<Base *>(instance));
+        };
+    } else {
+        return nullptr;
+    }
 }
 
 
-/**
- * Internal details not to be documented.
- * @endcond TURN_OFF_DOXYGEN
- */
+template<typename Type, typename Base>
+constexpr base_node base_node_of(base_node *next, meta::base(* const clazz)() noexcept) noexcept {
+    return {
+        &type_info<Type>::template base<Base>,
+        &type_info<Type>::node,
+        next,
+        &type_info<Base>::resolve,
+        &type_info<Base>::node,
+        [](void *instance) noexcept -> void * {
+            return static_cast<Base *>(static_cast<Type *>(instance));
+        },
+        downcast_of<Type, Base>(),
+        clazz
+    };
+}
 
 
-/**
- * @brief A meta factory to be used for reflection purposes.
- *
- * A meta factory is an utility class used to reflect types, data and functions
- * of all sorts. This class ensures that the underlying web of types is built
- * correctly and performs some checks in debug mode to ensure that there are no
- * subtle errors at runtime.
- *
- * @tparam Type Reflected type for which the factory was created.
- */
-template<typename Type>
-class factory {
-    template<typename Node>
-    bool duplicate(const std::size_t identifier, const Node *node) noexcept {
-        return node && (node->identifier == identifier || duplicate(identifier, node->next));
-    }
+template<typename Type, typename... Args>
+constexpr ctor_node ctor_node_of(ctor_node *next, meta::ctor(* const clazz)() noexcept) noexcept {
+    using helper_type = function_helper_t<Type(*)(Args...)>;
+
+    return {
+        &type_info<Type>::template ctor<typename helper_type::args_type>,
+        &type_info<Type>::node,
+        next,
+        nullptr,
+        helper_type::size,
+        &helper_type::arg,
+        [](any * const any) {
+            return construct<Type, std::remove_cv_t<std::remove_reference_t<Args>>...>(any, std::make_index_sequence<helper_type::size>{});
+        },
+        clazz
+    };
+}
 
-    bool duplicate(const any &key, const internal::prop_node *node) noexcept {
-        return node && (node->key() == key || duplicate(key, node->next));
-    }
 
-    template<typename>
-    internal::prop_node * properties() {
-        return nullptr;
-    }
+template<typename Class, typename Member>
+Class member_class(Member Class:: *);
 
-    template<typename Owner, typename Property, typename... Other>
-    internal::prop_node * properties(Property &&property, Other &&... other) {
-        static std::remove_cv_t<std::remove_reference_t<Property>> prop{};
 
-        static internal::prop_node node{
-            nullptr,
-            []() -> any {
-                return std::as_const(std::get<0>(prop));
-            },
-            []() -> any {
-                return std::as_const(std::get<1>(prop));
-            },
-            []() noexcept -> meta::prop {
-                return &node;
-            }
-        };
+template<typename Type, typename Class, typename = void>
+struct fixed_offset: std::false_type {};
 
-        prop = std::forward<Property>(property);
-        node.next = properties<Owner>(std::forward<Other>(other)...);
-        assert(!duplicate(any{std::get<0>(prop)}, node.next));
-        return &node;
-    }
 
-    void unregister_prop(internal::prop_node **prop) {
-        while(*prop) {
-            auto *node = *prop;
-            *prop = node->next;
-            node->next = nullptr;
-        }
-    }
+// members of virtual bases aren't at a fixed offset from the derived class
+template<typename Type, typename Class>
+struct fixed_offset<Type, Class, std::void_t<decltype(static_cast<Type *>(std::declval<Class *>()))>>: std::true_type {};
 
-    void unregister_dtor() {
-        if(auto node = internal::type_info<Type>::type->dtor; node) {
-            internal::type_info<Type>::type->dtor = nullptr;
-            *node->underlying = nullptr;
-        }
-    }
 
-    template<auto Member>
-    auto unregister_all(int)
-    -> decltype((internal::type_info<Type>::type->*Member)->prop, void()) {
-        while(internal::type_info<Type>::type->*Member) {
-            auto node = internal::type_info<Type>::type->*Member;
-            internal::type_info<Type>::type->*Member = node->next;
-            unregister_prop(&node->prop);
-            node->next = nullptr;
-            *node->underlying = nullptr;
-        }
+template<typename Type, auto Data>
+void * address(void *instance) noexcept {
+    return const_cast<void *>(static_cast<const void *>(std::addressof(static_cast<Type *>(instance)->*Data)));
+}
+
+
+// offsets are taken from a real instance, types that cannot be constructed silently have none
+template<typename Type, typename Class>
+struct known_offset: std::bool_constant<fixed_offset<Type, Class>::value && std::is_nothrow_default_constructible_v<Type>> {};
+
+
+template<typename Type, typename Base>
+std::size_t base_offset() noexcept {
+    std::size_t offset{};
+
+    if constexpr(known_offset<Type, Base>::value) {
+        const Type instance{};
+        const auto *first = reinterpret_cast<const std::byte *>(std::addressof(instance));
+        offset = static_cast<std::size_t>(reinterpret_cast<const std::byte *>(static_cast<const Base *>(std::addressof(instance))) - first);
     }
 
-    template<auto Member>
-    void unregister_all(char) {
-        while(internal::type_info<Type>::type->*Member) {
-            auto node = internal::type_info<Type>::type->*Member;
-            internal::type_info<Type>::type->*Member = node->next;
-            node->next = nullptr;
-            *node->underlying = nullptr;
+    return offset;
+}
+
+
+template<typename Type, auto Data>
+std::size_t offset_of() noexcept {
+    std::size_t offset{};
+
+    if constexpr(std::is_member_object_pointer_v<decltype(Data)>) {
+        if constexpr(known_offset<Type, decltype(member_class(Data))>::value) {
+            Type instance{};
+            auto *first = reinterpret_cast<std::byte *>(std::addressof(instance));
+            offset = static_cast<std::size_t>(static_cast<std::byte *>(address<Type, Data>(first)) - first);
         }
     }
 
-public:
-    /*! @brief Default constructor. */
-    factory() noexcept = default;
+    return offset;
+}
 
-    /**
-     * @brief Extends a meta type by assigning it an identifier and properties.
-     * @tparam Property Types of properties to assign to the meta type.
-     * @param identifier Unique identifier.
-     * @param property Properties to assign to the meta type.
-     * @return A meta factory for the parent type.
-     */
-    template<typename... Property>
-    factory type(const std::size_t identifier, Property &&... property) noexcept {
-        assert(!internal::type_info<Type>::type);
-        auto *node = internal::type_info<Type>::resolve();
-        node->identifier = identifier;
-        node->next = internal::type_info<>::type;
-        node->prop = properties<Type>(std::forward<Property>(property)...);
-        assert(!duplicate(node->identifier, node->next));
-        internal::type_info<Type>::type = node;
-        internal::type_info<>::type = node;
 
-        return *this;
-    }
+template<typename Type, auto Data, typename Policy>
+constexpr data_node data_node_of(const std::size_t identifier, data_node *next, meta::data(* const clazz)() noexcept) noexcept {
+    if constexpr(std::is_same_v<Type, decltype(Data)>) {
+        static_assert(std::is_same_v<Policy, as_is_t>);
+
+        return {
+            &type_info<Type>::template data<Data>,
+            identifier,
+            &type_info<Type>::node,
+            next,
+            nullptr,
+            true,
+            true,
+            &type_info<Type>::resolve,
+            [](handle, any, any) { return false; },
+            [](handle, any) -> any { return Data; },
+            clazz
+        };
+    } else if constexpr(std::is_member_object_pointer_v<decltype(Data)>) {
+        using data_type = std::remove_reference_t<decltype(std::declval<Type>().*Data)>;
 
-    /**
+        return {
+            &type_info<Type>::template data<Data>,
+            identifier,
+            &type_info<Type>::node,
+            next,
+            nullptr,
+            std::is_const_v<data_type>,
+            !std::is_member_object_pointer_v<decltype(Data)>,
+            &type_info<data_type>::resolve,
+            &setter<std::is_const_v<data_type>, Type, Data>,
+            &getter<Type, Data, Policy>,
+            clazz,
+            {},
+            known_offset<Type, decltype(member_class(Data))>::value ? &address<Type, Data> : nullptr
+        };
+    } else {
+        static_assert(std::is_pointer_v<std::decay_t<decltype(Data)>>);
+        using data_type = std::remove_pointer_t<std::decay_t<decltype(Data)>>;
+
+        return {
+            &type_info<Type>::template data<Data>,
+            identifier,
+            &type_info<Type>::node,
+            next,
+            nullptr,
+            std::is_const_v<data_type>,
+            !std::is_member_object_pointer_v<decltype(Data)>,
+            &type_info<data_type>::resolve,
+            &setter<std::is_const_v<data_type>, Type, Data>,
+            &getter<Type, Data, Policy>,
+            clazz
+        };
+    }
+}
+
+
+template<typename Type, auto Candidate, typename Policy>
+constexpr func_node func_node_of(const std::size_t identifier, func_node *next, meta::func(* const clazz)() noexcept) noexcept {
+    using helper_type = function_helper_t<decltype(Candidate)>;
+
+    return {
+        &type_info<Type>::template func<Candidate>,
+        identifier,
+        &type_info<Type>::node,
+        next,
+        nullptr,
+        helper_type::size,
+        helper_type::is_const,
+        !std::is_member_function_pointer_v<decltype(Candidate)>,
+        &type_info<std::conditional_t<std::is_same_v<Policy, as_void_t>, void, typename helper_type::return_type>>::resolve,
+        &helper_type::arg,
+        [](handle handle, any *any) {
+            return invoke<Type, Candidate, Policy>(handle, any, std::make_index_sequence<helper_type::size>{});
+        },
+        clazz
+    };
+}
+
+
+template<typename, typename>
+struct static_part {
+    using node_type = void;
+    static constexpr std::size_t identifier = {};
+};
+
+
+template<typename Type, typename Base>
+struct static_part<Type, static_base<Base>> {
+    using node_type = base_node;
+    static constexpr std::size_t identifier = {};
+
+    static constexpr base_node make(base_node *next, meta::base(* const clazz)() noexcept) noexcept {
+        static_assert(std::is_base_of_v<Base, Type>);
+        return base_node_of<Type, Base>(next, clazz);
+    }
+
+    static void prepare(base_node &node) noexcept {
+        node.offset = base_offset<Type, Base>();
+        node.fixed = known_offset<Type, Base>::value;
+    }
+};
+
+
+template<typename Type, typename... Args>
+struct static_part<Type, static_ctor<Args...>> {
+    using node_type = ctor_node;
+    static constexpr std::size_t identifier = {};
+
+    static constexpr ctor_node make(ctor_node *next, meta::ctor(* const clazz)() noexcept) noexcept {
+        return ctor_node_of<Type, Args...>(next, clazz);
+    }
+};
+
+
+template<typename Type, auto Data, std::size_t Identifier, typename Policy>
+struct static_part<Type, static_data<Data, Identifier, Policy>> {
+    using node_type = data_node;
+    static constexpr std::size_t identifier = Identifier;
+
+    static constexpr data_node make(data_node *next, meta::data(* const clazz)() noexcept) noexcept {
+        return data_node_of<Type, Data, Policy>(Identifier, next, clazz);
+    }
+
+    static void prepare(data_node &node) noexcept {
+        node.offset = offset_of<Type, Data>();
+    }
+};
+
+
+template<typename Type, auto Candidate, std::size_t Identifier, typename Policy>
+struct static_part<Type, static_func<Candidate, Identifier, Policy>> {
+    using node_type = func_node;
+    static constexpr std::size_t identifier = Identifier;
+
+    static constexpr func_node make(func_node *next, meta::func(* const clazz)() noexcept) noexcept {
+        return func_node_of<Type, Candidate, Policy>(Identifier, next, clazz);
+    }
+};
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief A meta factory to be used for reflection purposes.
+ *
+ * A meta factory is an utility class used to reflect types, data and functions
+ * of all sorts. This class ensures that the underlying web of types is built
+ * correctly and performs some checks in debug mode to ensure that there are no
+ * subtle errors at runtime.
+ *
+ * @tparam Type Reflected type for which the factory was created.
+ */
+template<typename Type>
+class factory {
+    template<typename Node>
+    bool duplicate(const std::size_t identifier, const internal::link<Node> &head) noexcept {
+        const Node *node = head;
+        return node && (node->identifier == identifier || duplicate(identifier, node->next));
+    }
+
+    template<typename Node>
+    bool collision(const hashed_string &identifier, const internal::link<Node> &head) noexcept {
+        const Node *node = head;
+        return node && ((node->identifier == identifier && identifier.data() && !node->name.empty() && node->name != identifier.data()) || collision(identifier, node->next));
+    }
+
+    template<typename Node>
+    static auto rename(Node &node, const char *name, int) noexcept
+    -> decltype(node.name, void()) {
+        node.name = name ? std::string_view{name} : std::string_view{};
+    }
+
+    template<typename Node>
+    static void rename(Node &, const char *, char) noexcept {}
+
+    template<typename, typename Node>
+    internal::prop_node * properties(const Node *) {
+        return nullptr;
+    }
+
+    template<typename Owner, typename Node, typename Property, typename... Other>
+    internal::prop_node * properties(const Node *owner, Property &&property, Other &&... other) {
+        static std::remove_cv_t<std::remove_reference_t<Property>> prop{};
+
+        static internal::prop_node node{
+            nullptr,
+            []() -> any {
+                return std::as_const(std::get<0>(prop));
+            },
+            []() -> any {
+                return std::as_const(std::get<1>(prop));
+            },
+            []() noexcept -> any {
+                return any{std::ref(std::get<0>(prop))};
+            },
+            []() noexcept -> any {
+                return any{std::ref(std::get<1>(prop))};
+            },
+            []() noexcept -> meta::prop {
+                return &node;
+            },
+            internal::type_info<decltype(std::get<0>(prop))>::resolve(),
+            &std::get<0>(prop),
+            {}
+        };
+
+        prop = std::forward<Property>(property);
+        node.key_hash = internal::prop_hash(std::get<0>(prop));
+        node.next = properties<Owner>(owner, std::forward<Other>(other)...);
+        assert(!internal::find_if(internal::match_key(std::get<0>(prop)), node.next));
+
+        // properties are indexed with the context of the type they belong to
+        internal::context_node *owner_ctx = internal::type_info<Type>::node.ctx;
+        internal::untag<decltype(owner->clazz())>(node);
+        internal::tag(owner_ctx ? *owner_ctx : *ctx, node, owner->clazz);
+
+        return &node;
+    }
+
+    template<typename Node>
+    static void untag_all(const internal::link<Node> &head) {
+        for(const Node *curr = head; curr; curr = curr->next) {
+            for(internal::prop_node *prop = curr->prop; prop; prop = prop->next) {
+                internal::untag<decltype(curr->clazz())>(*prop);
+            }
+        }
+    }
+
+    template<typename Node>
+    void unregister_prop(internal::prop_node *curr) {
+        while(curr) {
+            internal::untag<decltype(std::declval<Node &>().clazz())>(*curr);
+            curr->tag = nullptr;
+            curr = curr->next.exchange(nullptr);
+        }
+    }
+
+    template<typename Node>
+    auto unregister_all(Node *curr, int)
+    -> decltype(curr->prop, void()) {
+        while(curr) {
+            unregister_prop<Node>(curr->prop.exchange(nullptr));
+            rename(*curr, nullptr, 0);
+            *curr->underlying = nullptr;
+            curr = curr->next.exchange(nullptr);
+        }
+    }
+
+    template<typename Node>
+    void unregister_all(Node *curr, char) {
+        while(curr) {
+            *curr->underlying = nullptr;
+            curr = curr->next.exchange(nullptr);
+        }
+    }
+
+    static void realize() noexcept {
+        static std::atomic<std::thread::id> owner{};
+        const auto self = std::this_thread::get_id();
+        auto &node = internal::type_info<Type>::node;
+
+        if(std::thread::id none{}; owner.compare_exchange_strong(none, self, std::memory_order_acq_rel)) {
+            // the callback runs without locks, it must not throw
+            if(node.pending.load(std::memory_order_acquire)) {
+                deferred(factory{});
+                std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+                node.pending.store(nullptr, std::memory_order_release);
+                thaw(node.ctx);
+            }
+
+            owner.store(std::thread::id{}, std::memory_order_release);
+        } else if(none != self) {
+            // the factory itself resolves the type while the callback is running, other threads wait
+            while(node.pending.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    static void track(const internal::type_node *node) {
+        if constexpr(std::is_polymorphic_v<Type>) {
+            internal::dynamic_cache::update(typeid(Type), node);
+        }
+    }
+
+    static void thaw(internal::context_node *owner) noexcept {
+        // mutations fall back to the regular nodes until the next freeze
+        if(owner) {
+            owner->thaw();
+        }
+    }
+
+    template<typename Part>
+    using static_node_type = typename internal::static_part<Type, Part>::node_type;
+
+    template<typename Node>
+    static constexpr Node * static_head() noexcept {
+        return nullptr;
+    }
+
+    template<typename Node, typename Part, typename... Other>
+    static constexpr Node * static_head() noexcept {
+        if constexpr(std::is_same_v<static_node_type<Part>, Node>) {
+            return &factory::template static_node<Part, Other...>;
+        } else {
+            return static_head<Node, Other...>();
+        }
+    }
+
+    template<typename Node>
+    static constexpr Node * static_tail() noexcept {
+        return nullptr;
+    }
+
+    template<typename Node, typename Part, typename... Other>
+    static constexpr Node * static_tail() noexcept {
+        if constexpr((std::is_same_v<static_node_type<Other>, Node> || ...)) {
+            return static_tail<Node, Other...>();
+        } else if constexpr(std::is_same_v<static_node_type<Part>, Node>) {
+            return &factory::template static_node<Part, Other...>;
+        } else {
+            return nullptr;
+        }
+    }
+
+    template<typename Part, typename... Other>
+    static auto static_clazz() noexcept
+    -> decltype(std::declval<static_node_type<Part> &>().clazz()) {
+        return &factory::template static_node<Part, Other...>;
+    }
+
+    template<typename Part, typename... Other>
+    inline static static_node_type<Part> static_node = internal::static_part<Type, Part>::make(
+        static_head<static_node_type<Part>, Other...>(),
+        &static_clazz<Part, Other...>
+    );
+
+    template<typename Node, typename... Part>
+    static constexpr bool static_unique() noexcept {
+        const std::array<bool, sizeof...(Part)> candidate{{std::is_same_v<static_node_type<Part>, Node>...}};
+        const std::array<std::size_t, sizeof...(Part)> identifier{{internal::static_part<Type, Part>::identifier...}};
+        bool unique = true;
+
+        for(std::size_t pos{}; pos < sizeof...(Part); ++pos) {
+            for(auto next = pos + 1; next < sizeof...(Part); ++next) {
+                unique = unique && !(candidate[pos] && candidate[next] && identifier[pos] == identifier[next]);
+            }
+        }
+
+        return unique;
+    }
+
+    template<typename Part, typename... Other>
+    static void static_slot() noexcept {
+        using node_type = static_node_type<Part>;
+        auto &node = factory::template static_node<Part, Other...>;
+
+        // links are restored on every registration, unregister resets them
+        node.next = static_head<node_type, Other...>();
+
+        if constexpr(std::is_same_v<node_type, internal::data_node> || std::is_same_v<node_type, internal::base_node>) {
+            internal::static_part<Type, Part>::prepare(node);
+        }
+
+        assert(!*node.underlying);
+        *node.underlying = &node;
+
+        if constexpr(sizeof...(Other) != 0) {
+            static_slot<Other...>();
+        }
+    }
+
+    template<typename Part, typename... Other>
+    bool static_duplicate() noexcept {
+        using node_type = static_node_type<Part>;
+        bool ret{};
+
+        if constexpr(std::is_same_v<node_type, internal::data_node> || std::is_same_v<node_type, internal::func_node>) {
+            const auto &node = factory::template static_node<Part, Other...>;
+            ret = duplicate(node.identifier, node.next);
+        }
+
+        if constexpr(sizeof...(Other) != 0) {
+            ret = ret || static_duplicate<Other...>();
+        }
+
+        return ret;
+    }
+
+    template<auto Member, typename... Part>
+    static void static_link(internal::type_node *node) noexcept {
+        using node_type = typename std::remove_reference_t<decltype(node->*Member)>::type;
+
+        if constexpr((std::is_same_v<static_node_type<Part>, node_type> || ...)) {
+            static_tail<node_type, Part...>()->next = node->*Member;
+            node->*Member = static_head<node_type, Part...>();
+        }
+    }
+
+public:
+    /*! @brief Default constructor. */
+    factory() noexcept = default;
+
+    /**
+     * @brief Constructs a meta factory for a given context.
+     * @param ctx The context with which to register the meta type.
+     */
+    explicit factory(context &ctx) noexcept
+        : ctx{&internal::context_node::from(ctx)}
+    {}
+
+    /**
+     * @brief Extends a meta type by assigning it an identifier and properties.
+     * @tparam Property Types of properties to assign to the meta type.
+     * @param identifier Unique identifier.
+     * @param property Properties to assign to the meta type.
+     * @return A meta factory for the parent type.
+     */
+    template<typename... Property>
+    factory type(const std::size_t identifier, Property &&... property) noexcept {
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        auto *node = internal::type_info<Type>::resolve();
+        assert(!node->ctx);
+        node->identifier = identifier;
+        node->next = ctx->type;
+        node->prop = properties<Type>(node, std::forward<Property>(property)...);
+        node->ctx = ctx;
+        node->unregister = []() { return factory{}.unregister(); };
+        assert(!duplicate(node->identifier, node->next));
+        internal::type_info<Type>::type = node;
+        ctx->type = node;
+        track(node);
+        internal::lookup_cache::invalidate();
+        thaw(ctx);
+
+        return *this;
+    }
+
+    /**
+     * @brief Extends a meta type by assigning it an identifier in the form of
+     * a hashed string and properties.
+     *
+     * This function works exactly like its counterpart that accepts a numeric
+     * identifier. However, the original string is kept as the name of the meta
+     * type and, in debug mode, identifiers are checked for collisions with
+     * those of the other types.
+     *
+     * @tparam Property Types of properties to assign to the meta type.
+     * @param identifier Unique identifier.
+     * @param property Properties to assign to the meta type.
+     * @return A meta factory for the parent type.
+     */
+    template<typename... Property>
+    factory type(const hashed_string &identifier, Property &&... property) noexcept {
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        assert(!collision(identifier, ctx->type));
+        type(identifier.value(), std::forward<Property>(property)...);
+        rename(internal::type_info<Type>::node, identifier.data(), 0);
+
+        return *this;
+    }
+
+    /**
+     * @brief Extends a meta type by means of a compile-time descriptor.
+     *
+     * The parts listed by the descriptor are linked to the meta type as a
+     * whole. This function does the same amount of work regardless of the
+     * number of parts, since the nodes are laid out and linked together at
+     * compile-time.
+     *
+     * @tparam Identifier Unique identifier.
+     * @tparam Part Parts of the meta type.
+     * @return A meta factory for the parent type.
+     */
+    template<std::size_t Identifier, typename... Part>
+    factory type(descriptor<Type, Identifier, Part...>) noexcept {
+        static_assert((!std::is_void_v<static_node_type<Part>> && ...));
+        static_assert(static_unique<internal::data_node, Part...>());
+        static_assert(static_unique<internal::func_node, Part...>());
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        auto *node = internal::type_info<Type>::resolve();
+        assert(!node->ctx);
+        node->identifier = Identifier;
+        node->next = ctx->type;
+        node->ctx = ctx;
+        node->unregister = []() { return factory{}.unregister(); };
+
+        if constexpr(sizeof...(Part) != 0) {
+            static_slot<Part...>();
+        }
+
+        static_link<&internal::type_node::base, Part...>(node);
+        static_link<&internal::type_node::ctor, Part...>(node);
+        static_link<&internal::type_node::data, Part...>(node);
+        static_link<&internal::type_node::func, Part...>(node);
+        assert(!duplicate(node->identifier, node->next));
+
+        if constexpr(sizeof...(Part) != 0) {
+            assert(!static_duplicate<Part...>());
+        }
+
+        internal::type_info<Type>::type = node;
+        ctx->type = node;
+        track(node);
+        internal::lookup_cache::invalidate();
+        thaw(ctx);
+
+        return *this;
+    }
+
+    /**
+     * @brief Extends the meta information of the given type on first use.
+     *
+     * The meta type is registered with the given identifier immediately, while
+     * the callback is invoked only the first time the type is looked up either
+     * by identifier or by type, or it's otherwise required (as an example, when
+     * an instance of the type is wrapped by a meta any). The callback receives
+     * a factory for the given type to use to attach data, functions and
+     * everything else to the meta type.<br/>
+     * Running the callback is thread-safe: concurrent lookups wait for it to
+     * finish and it's invoked exactly once per registration. No lock is held
+     * while the callback runs, so it can look up other types freely.
+     *
+     * @warning
+     * The callback is invoked from non-throwing code paths and must not throw.
+     * Moreover, it must not wait for other threads that look up the same type,
+     * since they wait for the callback in turn.
+     *
+     * @param identifier Unique identifier.
+     * @param callback A valid function to invoke on first use.
+     * @return A meta factory for the parent type.
+     */
+    factory defer(const std::size_t identifier, void(* callback)(factory)) noexcept {
+        assert(callback);
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        type(identifier);
+        deferred = callback;
+        internal::type_info<Type>::node.pending.store(&realize, std::memory_order_release);
+
+        return *this;
+    }
+
+    /**
      * @brief Assigns a meta base to a meta type.
      *
      * A reflected base class must be a real base class of the reflected type.
@@ -358,24 +1409,20 @@ public:
     factory base() noexcept {
         static_assert(std::is_base_of_v<Base, Type>);
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
-        static internal::base_node node{
-            &internal::type_info<Type>::template base<Base>,
-            type,
-            nullptr,
-            &internal::type_info<Base>::resolve,
-            [](void *instance) noexcept -> void * {
-                return static_cast<Base *>(static_cast<Type *>(instance));
-            },
-            []() noexcept -> meta::base {
-                return &node;
-            }
-        };
+        static internal::base_node node = internal::base_node_of<Type, Base>(nullptr, []() noexcept -> meta::base {
+            return &node;
+        });
 
         node.next = type->base;
+        node.offset = internal::base_offset<Type, Base>();
+        node.fixed = internal::known_offset<Type, Base>::value;
         assert((!internal::type_info<Type>::template base<Base>));
         internal::type_info<Type>::template base<Base> = &node;
         type->base = &node;
+        internal::lookup_cache::invalidate();
+        thaw(type->ctx);
 
         return *this;
     }
@@ -393,6 +1440,7 @@ public:
     factory conv() noexcept {
         static_assert(std::is_convertible_v<Type, To>);
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
         static internal::conv_node node{
             &internal::type_info<Type>::template conv<To>,
@@ -411,6 +1459,7 @@ public:
         assert((!internal::type_info<Type>::template conv<To>));
         internal::type_info<Type>::template conv<To> = &node;
         type->conv = &node;
+        internal::lookup_cache::invalidate();
 
         return *this;
     }
@@ -431,6 +1480,7 @@ public:
     factory conv() noexcept {
         using conv_type = std::invoke_result_t<decltype(Candidate), Type &>;
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
         static internal::conv_node node{
             &internal::type_info<Type>::template conv<conv_type>,
@@ -449,6 +1499,7 @@ public:
         assert((!internal::type_info<Type>::template conv<conv_type>));
         internal::type_info<Type>::template conv<conv_type> = &node;
         type->conv = &node;
+        internal::lookup_cache::invalidate();
 
         return *this;
     }
@@ -473,6 +1524,7 @@ public:
         using helper_type = internal::function_helper_t<decltype(Func)>;
         static_assert(std::is_same_v<typename helper_type::return_type, Type>);
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
         static internal::ctor_node node{
             &internal::type_info<Type>::template ctor<typename helper_type::args_type>,
@@ -490,10 +1542,11 @@ public:
         };
 
         node.next = type->ctor;
-        node.prop = properties<typename helper_type::args_type>(std::forward<Property>(property)...);
+        node.prop = properties<typename helper_type::args_type>(&node, std::forward<Property>(property)...);
         assert((!internal::type_info<Type>::template ctor<typename helper_type::args_type>));
         internal::type_info<Type>::template ctor<typename helper_type::args_type> = &node;
         type->ctor = &node;
+        internal::lookup_cache::invalidate();
 
         return *this;
     }
@@ -514,27 +1567,18 @@ public:
     factory ctor(Property &&... property) noexcept {
         using helper_type = internal::function_helper_t<Type(*)(Args...)>;
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
-        static internal::ctor_node node{
-            &internal::type_info<Type>::template ctor<typename helper_type::args_type>,
-            type,
-            nullptr,
-            nullptr,
-            helper_type::size,
-            &helper_type::arg,
-            [](any * const any) {
-                return internal::construct<Type, std::remove_cv_t<std::remove_reference_t<Args>>...>(any, std::make_index_sequence<helper_type::size>{});
-            },
-            []() noexcept -> meta::ctor {
-                return &node;
-            }
-        };
+        static internal::ctor_node node = internal::ctor_node_of<Type, Args...>(nullptr, []() noexcept -> meta::ctor {
+            return &node;
+        });
 
         node.next = type->ctor;
-        node.prop = properties<typename helper_type::args_type>(std::forward<Property>(property)...);
+        node.prop = properties<typename helper_type::args_type>(&node, std::forward<Property>(property)...);
         assert((!internal::type_info<Type>::template ctor<typename helper_type::args_type>));
         internal::type_info<Type>::template ctor<typename helper_type::args_type> = &node;
         type->ctor = &node;
+        internal::lookup_cache::invalidate();
 
         return *this;
     }
@@ -559,6 +1603,7 @@ public:
     factory dtor() noexcept {
         static_assert(std::is_invocable_v<decltype(Func), Type &>);
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
         static internal::dtor_node node{
             &internal::type_info<Type>::template dtor<Func>,
@@ -581,6 +1626,7 @@ public:
         assert((!internal::type_info<Type>::template dtor<Func>));
         internal::type_info<Type>::template dtor<Func> = &node;
         internal::type_info<Type>::type->dtor = &node;
+        internal::lookup_cache::invalidate();
 
         return *this;
     }
@@ -593,6 +1639,11 @@ public:
      * From a client's point of view, all the variables associated with the
      * reflected object will appear as if they were part of the type itself.
      *
+     * Offsets of data members are taken from a temporary instance created
+     * when the member is registered, if the type is nothrow default
+     * constructible. Members of other types are read and written through
+     * copies.
+     *
      * @tparam Data The actual variable to attach to the meta type.
      * @tparam Policy Optional policy (no policy set by default).
      * @tparam Property Types of properties to assign to the meta data.
@@ -602,81 +1653,51 @@ public:
      */
     template<auto Data, typename Policy = as_is_t, typename... Property>
     factory data(const std::size_t identifier, Property &&... property) noexcept {
+        using owner_type = std::integral_constant<decltype(Data), Data>;
         auto * const type = internal::type_info<Type>::resolve();
-        internal::data_node *curr = nullptr;
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
-        if constexpr(std::is_same_v<Type, decltype(Data)>) {
-            static_assert(std::is_same_v<Policy, as_is_t>);
-
-            static internal::data_node node{
-                &internal::type_info<Type>::template data<Data>,
-                {},
-                type,
-                nullptr,
-                nullptr,
-                true,
-                true,
-                &internal::type_info<Type>::resolve,
-                [](handle, any, any) { return false; },
-                [](handle, any) -> any { return Data; },
-                []() noexcept -> meta::data {
-                    return &node;
-                }
-            };
+        static internal::data_node node = internal::data_node_of<Type, Data, Policy>({}, nullptr, []() noexcept -> meta::data {
+            return &node;
+        });
 
-            node.prop = properties<std::integral_constant<Type, Data>>(std::forward<Property>(property)...);
-            curr = &node;
-        } else if constexpr(std::is_member_object_pointer_v<decltype(Data)>) {
-            using data_type = std::remove_reference_t<decltype(std::declval<Type>().*Data)>;
-
-            static internal::data_node node{
-                &internal::type_info<Type>::template data<Data>,
-                {},
-                type,
-                nullptr,
-                nullptr,
-                std::is_const_v<data_type>,
-                !std::is_member_object_pointer_v<decltype(Data)>,
-                &internal::type_info<data_type>::resolve,
-                &internal::setter<std::is_const_v<data_type>, Type, Data>,
-                &internal::getter<Type, Data, Policy>,
-                []() noexcept -> meta::data {
-                    return &node;
-                }
-            };
-
-            node.prop = properties<std::integral_constant<decltype(Data), Data>>(std::forward<Property>(property)...);
-            curr = &node;
-        } else {
-            static_assert(std::is_pointer_v<std::decay_t<decltype(Data)>>);
-            using data_type = std::remove_pointer_t<std::decay_t<decltype(Data)>>;
-
-            static internal::data_node node{
-                &internal::type_info<Type>::template data<Data>,
-                {},
-                type,
-                nullptr,
-                nullptr,
-                std::is_const_v<data_type>,
-                !std::is_member_object_pointer_v<decltype(Data)>,
-                &internal::type_info<data_type>::resolve,
-                &internal::setter<std::is_const_v<data_type>, Type, Data>,
-                &internal::getter<Type, Data, Policy>,
-                []() noexcept -> meta::data {
-                    return &node;
-                }
-            };
+        node.identifier = identifier;
+        node.next = type->data;
+        node.offset = internal::offset_of<Type, Data>();
+        node.prop = properties<owner_type>(&node, std::forward<Property>(property)...);
+        assert(!duplicate(node.identifier, node.next));
+        assert((!internal::type_info<Type>::template data<Data>));
+        internal::type_info<Type>::template data<Data> = &node;
+        type->data = &node;
+        internal::lookup_cache::invalidate();
+        thaw(type->ctx);
 
-            node.prop = properties<std::integral_constant<decltype(Data), Data>>(std::forward<Property>(property)...);
-            curr = &node;
-        }
+        return *this;
+    }
 
-        curr->identifier = identifier;
-        curr->next = type->data;
-        assert(!duplicate(curr->identifier, curr->next));
-        assert((!internal::type_info<Type>::template data<Data>));
-        internal::type_info<Type>::template data<Data> = curr;
-        type->data = curr;
+    /**
+     * @brief Assigns a meta data to a meta type by means of an identifier in
+     * the form of a hashed string.
+     *
+     * The original string is kept as the name of the meta data and, in debug
+     * mode, identifiers are checked for collisions with those of the other
+     * meta data of the type.
+     *
+     * @sa data
+     *
+     * @tparam Data The actual variable to attach to the meta type.
+     * @tparam Policy Optional policy (no policy set by default).
+     * @tparam Property Types of properties to assign to the meta data.
+     * @param identifier Unique identifier.
+     * @param property Properties to assign to the meta data.
+     * @return A meta factory for the parent type.
+     */
+    template<auto Data, typename Policy = as_is_t, typename... Property>
+    factory data(const hashed_string &identifier, Property &&... property) noexcept {
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        assert(!collision(identifier, internal::type_info<Type>::resolve()->data));
+        data<Data, Policy>(identifier.value(), std::forward<Property>(property)...);
+        rename(*internal::type_info<Type>::template data<Data>, identifier.data(), 0);
 
         return *this;
     }
@@ -709,6 +1730,7 @@ public:
         using underlying_type = std::invoke_result_t<decltype(Getter), Type &>;
         static_assert(std::is_invocable_v<decltype(Setter), Type &, underlying_type>);
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
         static internal::data_node node{
             &internal::type_info<Type>::template data<Setter, Getter>,
@@ -728,11 +1750,41 @@ public:
 
         node.identifier = identifier;
         node.next = type->data;
-        node.prop = properties<owner_type>(std::forward<Property>(property)...);
+        node.prop = properties<owner_type>(&node, std::forward<Property>(property)...);
         assert(!duplicate(node.identifier, node.next));
         assert((!internal::type_info<Type>::template data<Setter, Getter>));
         internal::type_info<Type>::template data<Setter, Getter> = &node;
         type->data = &node;
+        internal::lookup_cache::invalidate();
+        thaw(type->ctx);
+
+        return *this;
+    }
+
+    /**
+     * @brief Assigns a meta data to a meta type by means of its setter and
+     * getter and an identifier in the form of a hashed string.
+     *
+     * The original string is kept as the name of the meta data and, in debug
+     * mode, identifiers are checked for collisions with those of the other
+     * meta data of the type.
+     *
+     * @sa data
+     *
+     * @tparam Setter The actual function to use as a setter.
+     * @tparam Getter The actual function to use as a getter.
+     * @tparam Policy Optional policy (no policy set by default).
+     * @tparam Property Types of properties to assign to the meta data.
+     * @param identifier Unique identifier.
+     * @param property Properties to assign to the meta data.
+     * @return A meta factory for the parent type.
+     */
+    template<auto Setter, auto Getter, typename Policy = as_is_t, typename... Property>
+    factory data(const hashed_string &identifier, Property &&... property) noexcept {
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        assert(!collision(identifier, internal::type_info<Type>::resolve()->data));
+        data<Setter, Getter, Policy>(identifier.value(), std::forward<Property>(property)...);
+        rename(*internal::type_info<Type>::template data<Setter, Getter>, identifier.data(), 0);
 
         return *this;
     }
@@ -755,35 +1807,49 @@ public:
     template<auto Candidate, typename Policy = as_is_t, typename... Property>
     factory func(const std::size_t identifier, Property &&... property) noexcept {
         using owner_type = std::integral_constant<decltype(Candidate), Candidate>;
-        using helper_type = internal::function_helper_t<decltype(Candidate)>;
         auto * const type = internal::type_info<Type>::resolve();
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
 
-        static internal::func_node node{
-            &internal::type_info<Type>::template func<Candidate>,
-            {},
-            type,
-            nullptr,
-            nullptr,
-            helper_type::size,
-            helper_type::is_const,
-            !std::is_member_function_pointer_v<decltype(Candidate)>,
-            &internal::type_info<std::conditional_t<std::is_same_v<Policy, as_void_t>, void, typename helper_type::return_type>>::resolve,
-            &helper_type::arg,
-            [](handle handle, any *any) {
-                return internal::invoke<Type, Candidate, Policy>(handle, any, std::make_index_sequence<helper_type::size>{});
-            },
-            []() noexcept -> meta::func {
-                return &node;
-            }
-        };
+        static internal::func_node node = internal::func_node_of<Type, Candidate, Policy>({}, nullptr, []() noexcept -> meta::func {
+            return &node;
+        });
 
         node.identifier = identifier;
         node.next = type->func;
-        node.prop = properties<owner_type>(std::forward<Property>(property)...);
+        node.prop = properties<owner_type>(&node, std::forward<Property>(property)...);
         assert(!duplicate(node.identifier, node.next));
         assert((!internal::type_info<Type>::template func<Candidate>));
         internal::type_info<Type>::template func<Candidate> = &node;
         type->func = &node;
+        internal::lookup_cache::invalidate();
+        thaw(type->ctx);
+
+        return *this;
+    }
+
+    /**
+     * @brief Assigns a meta funcion to a meta type by means of an identifier in
+     * the form of a hashed string.
+     *
+     * The original string is kept as the name of the meta function and, in
+     * debug mode, identifiers are checked for collisions with those of the
+     * other meta functions of the type.
+     *
+     * @sa func
+     *
+     * @tparam Candidate The actual function to attach to the meta type.
+     * @tparam Policy Optional policy (no policy set by default).
+     * @tparam Property Types of properties to assign to the meta function.
+     * @param identifier Unique identifier.
+     * @param property Properties to assign to the meta function.
+     * @return A meta factory for the parent type.
+     */
+    template<auto Candidate, typename Policy = as_is_t, typename... Property>
+    factory func(const hashed_string &identifier, Property &&... property) noexcept {
+        std::lock_guard<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        assert(!collision(identifier, internal::type_info<Type>::resolve()->func));
+        func<Candidate, Policy>(identifier.value(), std::forward<Property>(property)...);
+        rename(*internal::type_info<Type>::template func<Candidate>, identifier.data(), 0);
 
         return *this;
     }
@@ -797,39 +1863,84 @@ public:
      * Base classes aren't unregistered but the link between the two types is
      * removed.
      *
+     * The parts of the meta type are detached immediately, while they are
+     * reset only after all the read guards that exist at the time of the call
+     * have been destroyed. Therefore, this function blocks until then.
+     *
      * @return True if the meta type exists, false otherwise.
      */
-    bool unregister() noexcept {
-        const auto registered = internal::type_info<Type>::type;
+    bool unregister() {
+        std::unique_lock<std::recursive_mutex> guard{internal::type_info<>::mutex};
+        internal::type_node * const node = internal::type_info<Type>::type;
 
-        if(registered) {
-            if(auto *curr = internal::type_info<>::type; curr == internal::type_info<Type>::type) {
-                internal::type_info<>::type = internal::type_info<Type>::type->next;
-            } else {
-                while(curr && curr->next != internal::type_info<Type>::type) {
-                    curr = curr->next;
+        if(node) {
+            node->pending.store(nullptr, std::memory_order_relaxed);
+            track(nullptr);
+
+            if(node->ctx) {
+                internal::link<internal::type_node> *curr = &node->ctx->type;
+
+                // the type isn't part of the list anymore if another thread is unregistering it
+                while(*curr && *curr != node) {
+                    curr = &(*curr)->next;
                 }
 
-                if(curr) {
-                    curr->next = internal::type_info<Type>::type->next;
+                if(*curr) {
+                    *curr = node->next;
                 }
             }
 
-            unregister_prop(&internal::type_info<Type>::type->prop);
-            unregister_all<&internal::type_node::base>(0);
-            unregister_all<&internal::type_node::conv>(0);
-            unregister_all<&internal::type_node::ctor>(0);
-            unregister_all<&internal::type_node::data>(0);
-            unregister_all<&internal::type_node::func>(0);
-            unregister_dtor();
+            // properties are no longer found by key, readers can still walk them
+            for(internal::prop_node *curr = node->prop; curr; curr = curr->next) {
+                internal::untag<meta::type>(*curr);
+            }
+
+            untag_all(node->ctor);
+            untag_all(node->data);
+            untag_all(node->func);
+
+            // readers can still walk the detached parts, they are reset later
+            auto * const prop = node->prop.exchange(nullptr);
+            auto * const base = node->base.exchange(nullptr);
+            auto * const conv = node->conv.exchange(nullptr);
+            auto * const ctor = node->ctor.exchange(nullptr);
+            auto * const dtor = node->dtor.exchange(nullptr);
+            auto * const data = node->data.exchange(nullptr);
+            auto * const func = node->func.exchange(nullptr);
+
+            node->frozen.store(nullptr, std::memory_order_relaxed);
+            thaw(node->ctx);
+            internal::lookup_cache::invalidate();
+
+            // readers could be waiting for the global mutex, it's released meanwhile
+            guard.unlock();
+            internal::epoch::synchronize();
+            guard.lock();
+
+            unregister_prop<internal::type_node>(prop);
+            unregister_all(base, 0);
+            unregister_all(conv, 0);
+            unregister_all(ctor, 0);
+            unregister_all(data, 0);
+            unregister_all(func, 0);
+
+            if(dtor) {
+                *dtor->underlying = nullptr;
+            }
 
-            internal::type_info<Type>::type->identifier = {};
-            internal::type_info<Type>::type->next = nullptr;
+            rename(*node, nullptr, 0);
+            node->identifier = {};
+            node->next = nullptr;
+            node->ctx = nullptr;
             internal::type_info<Type>::type = nullptr;
         }
 
-        return registered;
+        return node;
     }
+
+private:
+    inline static void(* deferred)(factory){nullptr};
+    internal::context_node *ctx{&internal::type_info<>::ctx};
 };
 
 
@@ -853,6 +1964,24 @@ inline factory<Type> reflect(const std::size_t identifier, Property &&... proper
 }
 
 
+/**
+ * @brief Utility function to use for reflection with an identifier in the form
+ * of a hashed string.
+ *
+ * @sa reflect
+ *
+ * @tparam Type Type to reflect.
+ * @tparam Property Types of properties to assign to the reflected type.
+ * @param identifier Unique identifier.
+ * @param property Properties to assign to the reflected type.
+ * @return A meta factory for the given type.
+ */
+template<typename Type, typename... Property>
+inline factory<Type> reflect(const hashed_string &identifier, Property &&... property) noexcept {
+    return factory<Type>{}.type(identifier, std::forward<Property>(property)...);
+}
+
+
 /**
  * @brief Utility function to use for reflection.
  *
@@ -870,6 +1999,123 @@ inline factory<Type> reflect() noexcept {
 }
 
 
+/**
+ * @brief Utility function to use for reflection by means of a descriptor.
+ *
+ * The meta type is created and extended at once with all the parts listed by
+ * the given descriptor.
+ *
+ * @tparam Type Type to reflect.
+ * @tparam Identifier Unique identifier.
+ * @tparam Part Parts of the meta type.
+ * @param desc A compile-time descriptor of the type to reflect.
+ * @return A meta factory for the given type.
+ */
+template<typename Type, std::size_t Identifier, typename... Part>
+inline factory<Type> reflect(descriptor<Type, Identifier, Part...> desc) noexcept {
+    return factory<Type>{}.type(desc);
+}
+
+
+/**
+ * @brief Utility function to use for reflection within a given context by
+ * means of a descriptor.
+ *
+ * The meta type is created, registered with the given context and extended at
+ * once with all the parts listed by the given descriptor.
+ *
+ * @tparam Type Type to reflect.
+ * @tparam Identifier Unique identifier.
+ * @tparam Part Parts of the meta type.
+ * @param ctx The context with which to register the type.
+ * @param desc A compile-time descriptor of the type to reflect.
+ * @return A meta factory for the given type.
+ */
+template<typename Type, std::size_t Identifier, typename... Part>
+inline factory<Type> reflect(context &ctx, descriptor<Type, Identifier, Part...> desc) noexcept {
+    return factory<Type>{ctx}.type(desc);
+}
+
+
+/**
+ * @brief Utility function to use for reflection within a given context.
+ *
+ * This is the point from which everything starts.<br/>
+ * By invoking this function with a type that is not yet reflected, a meta type
+ * is created and registered with the given context. It will be possible to
+ * attach data and functions to it through a dedicated factory.
+ *
+ * @tparam Type Type to reflect.
+ * @tparam Property Types of properties to assign to the reflected type.
+ * @param ctx The context with which to register the type.
+ * @param identifier Unique identifier.
+ * @param property Properties to assign to the reflected type.
+ * @return A meta factory for the given type.
+ */
+template<typename Type, typename... Property>
+inline factory<Type> reflect(context &ctx, const std::size_t identifier, Property &&... property) noexcept {
+    return factory<Type>{ctx}.type(identifier, std::forward<Property>(property)...);
+}
+
+
+/**
+ * @brief Utility function to use for reflection within a given context with an
+ * identifier in the form of a hashed string.
+ *
+ * @sa reflect
+ *
+ * @tparam Type Type to reflect.
+ * @tparam Property Types of properties to assign to the reflected type.
+ * @param ctx The context with which to register the type.
+ * @param identifier Unique identifier.
+ * @param property Properties to assign to the reflected type.
+ * @return A meta factory for the given type.
+ */
+template<typename Type, typename... Property>
+inline factory<Type> reflect(context &ctx, const hashed_string &identifier, Property &&... property) noexcept {
+    return factory<Type>{ctx}.type(identifier, std::forward<Property>(property)...);
+}
+
+
+/**
+ * @brief Utility function to use for lazy reflection.
+ *
+ * The type is registered with the given identifier immediately, while the
+ * callback that extends its meta information is invoked only on first use.
+ *
+ * @sa factory::defer
+ *
+ * @tparam Type Type to reflect.
+ * @param identifier Unique identifier.
+ * @param callback A valid function to invoke on first use.
+ * @return A meta factory for the given type.
+ */
+template<typename Type>
+inline factory<Type> defer(const std::size_t identifier, void(* callback)(factory<Type>)) noexcept {
+    return factory<Type>{}.defer(identifier, callback);
+}
+
+
+/**
+ * @brief Utility function to use for lazy reflection within a given context.
+ *
+ * The type is registered with the given context immediately, while the callback
+ * that extends its meta information is invoked only on first use.
+ *
+ * @sa factory::defer
+ *
+ * @tparam Type Type to reflect.
+ * @param ctx The context with which to register the type.
+ * @param identifier Unique identifier.
+ * @param callback A valid function to invoke on first use.
+ * @return A meta factory for the given type.
+ */
+template<typename Type>
+inline factory<Type> defer(context &ctx, const std::size_t identifier, void(* callback)(factory<Type>)) noexcept {
+    return factory<Type>{ctx}.defer(identifier, callback);
+}
+
+
 /**
  * @brief Utility function to unregister a type.
  *
@@ -879,17 +2125,255 @@ inline factory<Type> reflect() noexcept {
  * Base classes aren't unregistered but the link between the two types is
  * removed.
  *
+ * This function blocks until all the read guards that exist at the time of
+ * the call have been destroyed.
+ *
  * @tparam Type Type to unregister.
  * @return True if the type to unregister exists, false otherwise.
  */
 template<typename Type>
-inline bool unregister() noexcept {
+inline bool unregister() {
     return factory<Type>{}.unregister();
 }
 
 
+/**
+ * @brief Utility function to unregister a type from a given context.
+ *
+ * This function works exactly like its counterpart without a context, except
+ * for the fact that it does nothing if the type isn't registered with the given
+ * context.
+ *
+ * @tparam Type Type to unregister.
+ * @param ctx The context from which to unregister the type.
+ * @return True if the type to unregister exists within the given context, false
+ * otherwise.
+ */
+template<typename Type>
+inline bool unregister(context &ctx) {
+    const internal::type_node *node = internal::type_info<Type>::type;
+    return node && node->ctx == &internal::context_node::from(ctx) && factory<Type>{}.unregister();
+}
+
+
+/**
+ * @brief Compacts the global registry into a read-optimized arena.
+ *
+ * Meta types, meta data and meta functions are copied to a contiguous arena
+ * made of dense arrays. Lookups by identifier and iterations run over these
+ * arrays rather than following the links between nodes. Types registered
+ * with a deferred callback are realized before the arena is built.<br/>
+ * Modifying a type that belongs to a frozen registry thaws it, that is, the
+ * arena is detached and lookups walk the nodes again until the next call to
+ * this function. Detached arenas are released by the next call to this
+ * function once all the read guards that exist at the time of the call have
+ * been destroyed. Therefore, this function blocks until then.
+ */
+inline void freeze() {
+    internal::freeze(internal::type_info<>::ctx);
+}
+
+
+/**
+ * @brief Compacts a given context into a read-optimized arena.
+ *
+ * @sa freeze
+ *
+ * @param ctx The context to compact.
+ */
+inline void freeze(context &ctx) {
+    internal::freeze(internal::context_node::from(ctx));
+}
+
+
+/**
+ * @brief Iterable range of the meta objects that carry a given property.
+ *
+ * Elements are pairs made of a meta object and the matching property, in no
+ * particular order. A range walks the list of its key within the context while
+ * it's iterated, nothing is copied when it's created.
+ *
+ * Properties attached after the range has been created may not be part of it.
+ *
+ * @warning
+ * A read guard keeps the iterators valid while types are unregistered from
+ * another thread.
+ *
+ * @tparam Member Type of meta objects to search.
+ */
+template<typename Member>
+class tagged_range {
+    template<typename Key>
+    static const internal::prop_node * lookup(const internal::context_node &ctx, const Key &key) {
+        std::lock_guard guard{ctx.tag_mutex};
+        const auto &lists = ctx.tags[internal::tag_kind<Member>()];
+
+        if(const auto it = lists.find(internal::prop_hash(key)); it != lists.cend()) {
+            // all the elements of a list share the same key, only heads are compared
+            const auto head = std::find_if(it->second.cbegin(), it->second.cend(), internal::match_key(key));
+            return head == it->second.cend() ? nullptr : *head;
+        }
+
+        return nullptr;
+    }
+
+public:
+    /*! @brief Input iterator type. */
+    class iterator {
+        friend class tagged_range;
+
+        iterator(const internal::prop_node *node) noexcept
+            : curr{node}
+        {}
+
+    public:
+        /*! @brief Signed integer type. */
+        using difference_type = std::ptrdiff_t;
+        /*! @brief Type of elements, a meta object and the matching property. */
+        using value_type = std::pair<Member, meta::prop>;
+        /*! @brief Elements are returned by value. */
+        using pointer = void;
+        /*! @brief Elements are returned by value. */
+        using reference = value_type;
+        /*! @brief Iterator category. */
+        using iterator_category = std::input_iterator_tag;
+
+        /*! @brief Default constructor. */
+        iterator() noexcept = default;
+
+        /**
+         * @brief Moves to the next element.
+         * @return This iterator.
+         */
+        iterator & operator++() noexcept {
+            curr = curr->tag;
+            return *this;
+        }
+
+        /**
+         * @brief Moves to the next element.
+         * @return The iterator before the increment.
+         */
+        iterator operator++(int) noexcept {
+            iterator orig = *this;
+            return ++(*this), orig;
+        }
+
+        /**
+         * @brief Returns the element the iterator points to.
+         * @return A meta object and the matching property.
+         */
+        reference operator*() const {
+            return { reinterpret_cast<Member(*)() noexcept>(curr->owner)(), curr->clazz() };
+        }
+
+        /**
+         * @brief Checks if two iterators point to the same element.
+         * @param other Iterator with which to compare.
+         * @return True if the iterators point to the same element, false
+         * otherwise.
+         */
+        bool operator==(const iterator &other) const noexcept {
+            return curr == other.curr;
+        }
+
+        /**
+         * @brief Checks if two iterators point to different elements.
+         * @param other Iterator with which to compare.
+         * @return False if the iterators point to the same element, true
+         * otherwise.
+         */
+        bool operator!=(const iterator &other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        const internal::prop_node *curr{};
+    };
+
+    /**
+     * @brief Constructs a range for a given context and key.
+     * @tparam Key Type of key to use to search for properties.
+     * @param ctx The context to search.
+     * @param key The key to use to search for properties.
+     */
+    template<typename Key>
+    tagged_range(const internal::context_node &ctx, const Key &key)
+        : first{lookup(ctx, key)}
+    {}
+
+    /**
+     * @brief Returns an iterator to the first element.
+     * @return An iterator to the first element.
+     */
+    iterator begin() const noexcept {
+        return iterator{first};
+    }
+
+    /**
+     * @brief Returns an iterator past the last element.
+     * @return An iterator past the last element.
+     */
+    iterator end() const noexcept {
+        return iterator{nullptr};
+    }
+
+private:
+    const internal::prop_node *first;
+};
+
+
+/**
+ * @brief Returns the meta objects of a context that carry a given property.
+ *
+ * Properties are indexed by key within the context of the type they belong to,
+ * one list per distinct key. Therefore, the time spent to find the meta
+ * objects is proportional to the number of them rather than to the size of the
+ * registry or to the number of properties with colliding hashes:
+ *
+ * @code{.cpp}
+ * for(auto [data, prop]: meta::tagged<meta::data>(ctx, hash("serialize"))) {
+ *     // ...
+ * }
+ * @endcode
+ *
+ * @tparam Member Type of meta objects to search, either meta types, meta data,
+ * meta functions or meta constructors.
+ * @tparam Key Type of key to use to search for properties.
+ * @param ctx The context to search.
+ * @param key The key to use to search for properties.
+ * @return An iterable range of the meta objects found.
+ */
+template<typename Member, typename Key>
+inline tagged_range<Member> tagged(const context &ctx, const Key &key) {
+    return { internal::context_node::from(ctx), key };
+}
+
+
+/**
+ * @brief Returns the meta objects of the default context that carry a given
+ * property.
+ *
+ * @sa tagged
+ *
+ * @tparam Member Type of meta objects to search, either meta types, meta data,
+ * meta functions or meta constructors.
+ * @tparam Key Type of key to use to search for properties.
+ * @param key The key to use to search for properties.
+ * @return An iterable range of the meta objects found.
+ */
+template<typename Member, typename Key>
+inline tagged_range<Member> tagged(const Key &key) {
+    return { internal::type_info<>::ctx, key };
+}
+
+
 /**
  * @brief Returns the meta type associated with a given type.
+ *
+ * There exists a single meta type for each type. It's returned no matter what
+ * context the type is registered with, if any.
+ *
  * @tparam Type Type to use to search for a meta type.
  * @return The meta type associated with the given type, if any.
  */
@@ -899,17 +2383,75 @@ inline type resolve() noexcept {
 }
 
 
+/**
+ * @brief Returns the meta type associated with a given type within a given
+ * context.
+ *
+ * @sa resolve
+ *
+ * @tparam Type Type to use to search for a meta type.
+ * @param ctx The context in which to search for the meta type.
+ * @return The meta type associated with the given type, if it's registered
+ * with the given context, an invalid meta type otherwise.
+ */
+template<typename Type>
+inline type resolve(const context &ctx) noexcept {
+    const internal::type_node *node = internal::type_info<Type>::type;
+    return (node && node->ctx == &internal::context_node::from(ctx)) ? internal::realize(node)->clazz() : type{};
+}
+
+
 /**
  * @brief Returns the meta type associated with a given identifier.
  * @param identifier Unique identifier.
  * @return The meta type associated with the given identifier, if any.
  */
 inline type resolve(const std::size_t identifier) noexcept {
-    const auto *curr = internal::find_if([identifier](auto *node) {
-        return node->identifier == identifier;
-    }, internal::type_info<>::type);
+    return internal::resolve(internal::type_info<>::ctx, identifier);
+}
+
+
+/**
+ * @brief Returns the meta type associated with a given identifier within a
+ * given context.
+ * @param ctx The context in which to search for the meta type.
+ * @param identifier Unique identifier.
+ * @return The meta type associated with the given identifier, if any.
+ */
+inline type resolve(const context &ctx, const std::size_t identifier) noexcept {
+    return internal::resolve(internal::context_node::from(ctx), identifier);
+}
+
+
+/**
+ * @brief Returns the meta type associated with a given name.
+ *
+ * Names are looked up by means of their hash, exactly as it happens with
+ * identifiers. The name of the candidate is compared afterwards to verify the
+ * match.
+ *
+ * @param name The name of the meta type to search for.
+ * @return The meta type associated with the given name, if any.
+ */
+inline type resolve(const std::string_view name) noexcept {
+    const auto type = resolve(hashed_string::value(name.data(), name.size()));
+    return (type && type.name() == name) ? type : meta::type{};
+}
+
 
-    return curr ? curr->clazz() : type{};
+/**
+ * @brief Returns the meta type associated with a given name within a given
+ * context.
+ *
+ * @sa resolve
+ *
+ * @param ctx The context in which to search for the meta type.
+ * @param name The name of the meta type to search for.
+ * @return The meta type associated with the given name, if any.
+ */
+inline type resolve(const context &ctx, const std::string_view name) noexcept {
+    const auto type = resolve(ctx, hashed_string::value(name.data(), name.size()));
+    return (type && type.name() == name) ? type : meta::type{};
 }
 
 
@@ -922,8 +2464,23 @@ template<typename Op>
 inline std::enable_if_t<std::is_invocable_v<Op, type>, void>
 resolve(Op op) noexcept {
     internal::iterate([op = std::move(op)](auto *node) {
-        op(node->clazz());
-    }, internal::type_info<>::type);
+        op(internal::realize(node)->clazz());
+    }, internal::type_info<>::ctx);
+}
+
+
+/**
+ * @brief Iterates all the types reflected within a given context.
+ * @tparam Op Type of the function object to invoke.
+ * @param ctx The context whose types are to be iterated.
+ * @param op A valid function object.
+ */
+template<typename Op>
+inline std::enable_if_t<std::is_invocable_v<Op, type>, void>
+resolve(const context &ctx, Op op) noexcept {
+    internal::iterate([op = std::move(op)](auto *node) {
+        op(internal::realize(node)->clazz());
+    }, internal::context_node::from(ctx));
 }
 
 
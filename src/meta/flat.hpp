@@ -0,0 +1,442 @@
+#ifndef META_FLAT_HPP
+#define META_FLAT_HPP
+
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+#include "meta.hpp"
+
+
+namespace meta {
+
+
+/**
+ * @brief Array or string stored in a flat image.
+ *
+ * A flat span refers to a contiguous sequence of elements by means of an
+ * offset relative to the span itself. Therefore, it remains valid wherever
+ * the image is loaded or mapped, as long as the image is left untouched.
+ *
+ * @tparam Type Type of elements, it must be trivially copyable.
+ */
+template<typename Type>
+struct flat_span {
+    static_assert(std::is_trivially_copyable_v<Type>);
+
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Returns a pointer to the first element.
+     * @return A pointer to the first element, if any.
+     */
+    const Type * data() const noexcept {
+        return count ? reinterpret_cast<const Type *>(reinterpret_cast<const std::byte *>(this) + offset) : nullptr;
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     * @return The number of elements.
+     */
+    size_type size() const noexcept {
+        return static_cast<size_type>(count);
+    }
+
+    /**
+     * @brief Returns an iterator to the first element.
+     * @return An iterator to the first element.
+     */
+    const Type * begin() const noexcept {
+        return data();
+    }
+
+    /**
+     * @brief Returns an iterator past the last element.
+     * @return An iterator past the last element.
+     */
+    const Type * end() const noexcept {
+        return data() + size();
+    }
+
+    /**
+     * @brief Returns the element at a given position.
+     * @param pos Position of the element to return.
+     * @return A reference to the requested element.
+     */
+    const Type & operator[](const size_type pos) const noexcept {
+        assert(pos < size());
+        return data()[pos];
+    }
+
+    /*! @brief Offset of the first element, relative to the span. */
+    std::int64_t offset;
+    /*! @brief Number of elements. */
+    std::uint64_t count;
+};
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+struct flat_header {
+    static constexpr std::uint64_t signature = 0x74616c66'6174656dull;
+    static constexpr std::size_t alignment = alignof(std::max_align_t);
+
+    std::uint64_t magic;
+    std::uint64_t schema;
+    std::uint64_t size;
+    std::uint64_t count;
+    std::uint64_t first;
+};
+
+
+inline std::size_t flat_align(const std::size_t offset, const std::size_t alignment) noexcept {
+    return (offset + alignment - 1u) / alignment * alignment;
+}
+
+
+template<typename Op>
+void flat_members(const type_node *node, const std::size_t position, Op &op) {
+    op(node, position);
+
+    for(auto &&curr: schema_fields(node)) {
+        if(curr.data->address) {
+            flat_members(curr.data->ref(), position + curr.offset, op);
+        }
+    }
+
+    // bases of trivially copyable types are at fixed offsets, as long as they are known
+    for(internal::base_node *curr = node->base; curr; curr = curr->next) {
+        if(curr->fixed) {
+            flat_members(curr->ref(), position + curr->offset, op);
+        }
+    }
+}
+
+
+inline bool flat(const type_node *node) {
+    constexpr auto pointers = meta::traits::is_pointer | meta::traits::is_member_object_pointer | meta::traits::is_member_function_pointer;
+    bool valid = true;
+
+    auto op = [&valid](const type_node *curr, std::size_t) {
+        valid = valid && (curr->traits & meta::traits::is_trivially_copyable) != meta::traits::none && (curr->traits & pointers) == meta::traits::none;
+
+        for(internal::base_node *base = curr->base; base; base = base->next) {
+            valid = valid && base->fixed;
+        }
+    };
+
+    flat_members(node, 0u, op);
+
+    return valid && node->size;
+}
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief Writer for flat images.
+ *
+ * A flat image contains a sequence of objects of the same type, stored
+ * exactly as they are in memory, followed by the elements of their arrays and
+ * strings. It can be written to a file and mapped back into memory to be
+ * accessed without any parsing.<br/>
+ * Only trivially copyable types without pointers are accepted. Reflected
+ * types are walked member by member to look for pointers and spans, while the
+ * others are copied as they are.
+ *
+ * Arrays and strings are added first and then assigned to the members of the
+ * objects that refer to them. Spans returned by a writer are meaningful only
+ * to the writer itself until the image is finalized.
+ */
+class flat_writer {
+    struct patch {
+        bool heap;
+        std::size_t position;
+    };
+
+    void place(std::vector<std::byte> &region, const bool heap, const internal::type_node *node, const void *instance, const std::size_t count) {
+        const auto first = region.size();
+        const auto *bytes = static_cast<const std::byte *>(instance);
+        region.insert(region.end(), bytes, bytes + count * node->size);
+
+        std::vector<std::size_t> offsets{};
+
+        auto op = [this, &offsets](const internal::type_node *curr, const std::size_t position) {
+            if(std::find(spans.cbegin(), spans.cend(), curr) != spans.cend()) {
+                offsets.push_back(position);
+            }
+        };
+
+        // the layout is walked once, all the elements have their spans at the same offsets
+        internal::flat_members(node, 0u, op);
+
+        for(std::size_t pos{}; !offsets.empty() && pos < count; ++pos) {
+            for(auto offset: offsets) {
+                patches.push_back({ heap, first + pos * node->size + offset });
+            }
+        }
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Adds an array to the image.
+     * @tparam Type Type of elements.
+     * @param first A pointer to the first element of the array.
+     * @param count Number of elements of the array.
+     * @return A span to assign to the object that refers to the array.
+     */
+    template<typename Type>
+    flat_span<Type> span(const Type *first, const size_type count) {
+        static_assert(std::is_trivially_copyable_v<Type>);
+
+        if(auto *node = internal::type_info<flat_span<Type>>::resolve(); std::find(spans.cbegin(), spans.cend(), node) == spans.cend()) {
+            spans.push_back(node);
+        }
+
+        heap.resize(internal::flat_align(heap.size(), alignof(Type)));
+        const auto position = heap.size();
+        place(heap, true, internal::type_info<Type>::resolve(), first, count);
+
+        return { static_cast<std::int64_t>(position), static_cast<std::uint64_t>(count) };
+    }
+
+    /**
+     * @brief Adds a string to the image.
+     * @param str The string to add.
+     * @return A span to assign to the object that refers to the string.
+     */
+    flat_span<char> span(const std::string_view str) {
+        return span(str.data(), str.size());
+    }
+
+    /**
+     * @brief Appends an object to the image.
+     *
+     * All the objects of an image must be of the same type.
+     *
+     * @param handle A handle to the object to append.
+     * @return True in case of success, false otherwise.
+     */
+    bool add(handle handle) {
+        if(!handle || (root && handle.node != root) || !internal::flat(handle.node)) {
+            return false;
+        }
+
+        root = handle.node;
+        place(roots, false, root, handle.instance, 1u);
+
+        return true;
+    }
+
+    /**
+     * @brief Finalizes the image and returns it.
+     *
+     * The writer is left empty and can be reused to create another image.
+     *
+     * @return The flat image.
+     */
+    std::vector<std::byte> release() {
+        using header_type = internal::flat_header;
+        const auto first = internal::flat_align(sizeof(header_type), header_type::alignment);
+        const auto base = internal::flat_align(first + roots.size(), header_type::alignment);
+        std::vector<std::byte> image(base + heap.size());
+
+        const header_type header{
+            header_type::signature,
+            root ? internal::schema_hash(root) : 0u,
+            root ? root->size : 0u,
+            root ? roots.size() / root->size : 0u,
+            first
+        };
+
+        std::memcpy(image.data(), &header, sizeof(header));
+        std::copy(roots.cbegin(), roots.cend(), image.begin() + first);
+        std::copy(heap.cbegin(), heap.cend(), image.begin() + base);
+
+        for(auto &&curr: patches) {
+            // offsets are relative to the heap until here, they become relative to the spans
+            const auto position = (curr.heap ? base : first) + curr.position;
+            std::int64_t offset{};
+            std::memcpy(&offset, image.data() + position, sizeof(offset));
+            offset += static_cast<std::int64_t>(base) - static_cast<std::int64_t>(position);
+            std::memcpy(image.data() + position, &offset, sizeof(offset));
+        }
+
+        roots.clear();
+        heap.clear();
+        patches.clear();
+        root = nullptr;
+
+        return image;
+    }
+
+private:
+    std::vector<std::byte> roots{};
+    std::vector<std::byte> heap{};
+    std::vector<patch> patches{};
+    std::vector<const internal::type_node *> spans{};
+    const internal::type_node *root{};
+};
+
+
+/**
+ * @brief Read-only view of a flat image.
+ *
+ * A view doesn't copy nor parse the image. It only checks its header and
+ * returns handles that point directly into it. Therefore, opening an image
+ * takes the same time regardless of its size and, when the image is mapped
+ * from a file, pages are loaded on demand.
+ *
+ * Only the header is validated when an image is opened. Spans are trusted
+ * and accessed as they are, use `data` to check them when the image comes
+ * from an untrusted source.
+ *
+ * @warning
+ * A view doesn't own the image. Therefore, the latter must outlive the
+ * former, as well as all the handles returned by the view.<br/>
+ * Objects are meant to be read only. Writing through the handles returned by
+ * a view results in undefined behavior if the image is mapped as read-only.
+ */
+class flat_view {
+    using header_type = internal::flat_header;
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /*! @brief Default constructor. */
+    flat_view() noexcept
+        : node{},
+          first{},
+          last{},
+          count{}
+    {}
+
+    /**
+     * @brief Opens a flat image.
+     *
+     * The view is invalid if the image doesn't contain objects of the given
+     * type or if their layout differs from that of the type in memory.
+     *
+     * @param type The type of the objects in the image.
+     * @param data A pointer to the image, suitably aligned.
+     * @param size The size of the image in bytes.
+     */
+    flat_view(const meta::type &type, const void *data, const size_type size)
+        : flat_view{}
+    {
+        header_type header{};
+
+        if(type && data && size >= sizeof(header_type)) {
+            std::memcpy(&header, data, sizeof(header));
+
+            if(header.magic == header_type::signature && header.size == type.node->size && header.first <= size
+                    && header.count <= (size - header.first) / (header.size ? header.size : 1u) && header.schema == type.schema_hash())
+            {
+                node = type.node;
+                first = static_cast<const std::byte *>(data) + header.first;
+                last = static_cast<const std::byte *>(data) + size;
+                count = static_cast<size_type>(header.count);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of objects in the image.
+     * @return The number of objects in the image.
+     */
+    size_type size() const noexcept {
+        return count;
+    }
+
+    /**
+     * @brief Returns a handle to the object at a given position.
+     * @param pos Position of the object to return.
+     * @return A handle to the requested object.
+     */
+    handle operator[](const size_type pos) const noexcept {
+        assert(pos < count);
+        handle elem{};
+        elem.node = node;
+        elem.instance = const_cast<std::byte *>(first + pos * node->size);
+        return elem;
+    }
+
+    /**
+     * @brief Returns the elements of a span after checking its bounds.
+     *
+     * The span must be part of an object of the image. It's valid if all its
+     * elements are within the image and suitably aligned.
+     *
+     * @tparam Type Type of elements.
+     * @param span A span that is part of an object of the image.
+     * @return A pointer to the first element of the span, a null pointer if
+     * the span is empty or invalid.
+     */
+    template<typename Type>
+    const Type * data(const flat_span<Type> &span) const noexcept {
+        // addresses are compared as integers, the span may not be part of the image at all
+        const auto lower = reinterpret_cast<std::uintptr_t>(first);
+        const auto upper = reinterpret_cast<std::uintptr_t>(last);
+        const auto self = reinterpret_cast<std::uintptr_t>(&span);
+        const Type *elem = nullptr;
+
+        if(node && span.count && self >= lower && self < upper && sizeof(span) <= upper - self) {
+            const auto position = static_cast<std::int64_t>(self - lower);
+            const auto length = static_cast<std::int64_t>(upper - lower);
+
+            if(span.offset >= -position && span.offset <= length - position) {
+                const auto offset = static_cast<size_type>(position + span.offset);
+
+                if((lower + offset) % alignof(Type) == 0u && span.count <= (static_cast<size_type>(length) - offset) / sizeof(Type)) {
+                    elem = span.data();
+                }
+            }
+        }
+
+        return elem;
+    }
+
+    /**
+     * @brief Returns false if a view is invalid, true otherwise.
+     * @return False if the view is invalid, true otherwise.
+     */
+    explicit operator bool() const noexcept {
+        return node;
+    }
+
+private:
+    const internal::type_node *node;
+    const std::byte *first;
+    const std::byte *last;
+    size_type count;
+};
+
+
+}
+
+
+#endif // META_FLAT_HPP
@@ -0,0 +1,177 @@
+#ifndef META_HASHED_STRING_HPP
+#define META_HASHED_STRING_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace meta {
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+template<std::size_t>
+struct fnv1a_traits;
+
+
+template<>
+struct fnv1a_traits<4u> {
+    static constexpr std::uint32_t offset = 2166136261u;
+    static constexpr std::uint32_t prime = 16777619u;
+};
+
+
+template<>
+struct fnv1a_traits<8u> {
+    static constexpr std::uint64_t offset = 14695981039346656037ull;
+    static constexpr std::uint64_t prime = 1099511628211ull;
+};
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief Zero overhead unique identifier.
+ *
+ * A hashed string is a compile-time tool that allows users to use
+ * human-readable identifers in the codebase while using their numeric
+ * counterparts at runtime.<br/>
+ * Because of that, a hashed string can also be used in constant expressions if
+ * required. The hash function is FNV-1a, either the 32 or 64 bits version
+ * depending on the size of `std::size_t`.
+ *
+ * @warning
+ * The hashed string doesn't copy the string it's constructed from. Therefore,
+ * the latter must outlive the former. This is always the case with string
+ * literals.
+ */
+class hashed_string {
+    using traits_type = internal::fnv1a_traits<sizeof(std::size_t)>;
+
+public:
+    /*! @brief Unsigned integer type. */
+    using hash_type = std::size_t;
+
+    /**
+     * @brief Returns directly the numeric representation of a string.
+     * @param str Human-readable identifer.
+     * @return The numeric representation of the string.
+     */
+    static constexpr hash_type value(const char *str) noexcept {
+        auto partial{traits_type::offset};
+
+        while(*str) {
+            partial = (partial ^ static_cast<unsigned char>(*(str++))) * traits_type::prime;
+        }
+
+        return static_cast<hash_type>(partial);
+    }
+
+    /**
+     * @brief Returns directly the numeric representation of a string view.
+     * @param str Human-readable identifer.
+     * @param size Length of the string to hash.
+     * @return The numeric representation of the string.
+     */
+    static constexpr hash_type value(const char *str, std::size_t size) noexcept {
+        auto partial{traits_type::offset};
+
+        while(size--) {
+            partial = (partial ^ static_cast<unsigned char>(*(str++))) * traits_type::prime;
+        }
+
+        return static_cast<hash_type>(partial);
+    }
+
+    /*! @brief Constructs an empty hashed string. */
+    constexpr hashed_string() noexcept
+        : str{nullptr}, hash{}
+    {}
+
+    /**
+     * @brief Constructs a hashed string from a null-terminated string.
+     * @param curr Human-readable identifer.
+     */
+    constexpr hashed_string(const char *curr) noexcept
+        : str{curr}, hash{value(curr)}
+    {}
+
+    /**
+     * @brief Returns the human-readable representation of a hashed string.
+     * @return The string used to initialize the instance.
+     */
+    constexpr const char * data() const noexcept {
+        return str;
+    }
+
+    /**
+     * @brief Returns the numeric representation of a hashed string.
+     * @return The numeric representation of the instance.
+     */
+    constexpr hash_type value() const noexcept {
+        return hash;
+    }
+
+    /**
+     * @brief Returns the numeric representation of a hashed string.
+     * @return The numeric representation of the instance.
+     */
+    constexpr operator hash_type() const noexcept {
+        return hash;
+    }
+
+    /**
+     * @brief Compares two hashed strings.
+     * @param other Hashed string with which to compare.
+     * @return True if the two hashed strings are identical, false otherwise.
+     */
+    constexpr bool operator==(const hashed_string &other) const noexcept {
+        return hash == other.hash;
+    }
+
+private:
+    const char *str;
+    hash_type hash;
+};
+
+
+/**
+ * @brief Compares two hashed strings.
+ * @param lhs A valid hashed string.
+ * @param rhs A valid hashed string.
+ * @return True if the two hashed strings are identical, false otherwise.
+ */
+constexpr bool operator!=(const hashed_string &lhs, const hashed_string &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+
+}
+
+
+/**
+ * @brief User defined literal for hashed strings.
+ * @param str The literal without its suffix.
+ * @return A properly initialized hashed string.
+ */
+constexpr meta::hashed_string operator"" _hs(const char *str, std::size_t) noexcept {
+    return meta::hashed_string{str};
+}
+
+
+#endif // META_HASHED_STRING_HPP
@@ -0,0 +1,838 @@
+#ifndef META_JSON_HPP
+#define META_JSON_HPP
+
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <charconv>
+#include <system_error>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include "hashed_string.hpp"
+#include "meta.hpp"
+
+
+namespace meta {
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+struct json_codec {
+    void(* write)(std::string &, const void *);
+    bool(* read)(const char *&, const char *, void *);
+};
+
+
+inline void json_skip(const char *&curr, const char *last) noexcept {
+    while(curr != last && (*curr == ' ' || *curr == '\t' || *curr == '\n' || *curr == '\r')) {
+        ++curr;
+    }
+}
+
+
+inline bool json_literal(const char *&curr, const char *last, const std::string_view literal) noexcept {
+    if(static_cast<std::size_t>(last - curr) >= literal.size() && std::string_view{curr, literal.size()} == literal) {
+        curr += literal.size();
+        return true;
+    }
+
+    return false;
+}
+
+
+inline void json_escape(std::string &out, const std::string_view str) {
+    constexpr char digits[] = "0123456789abcdef";
+    out += '"';
+
+    for(const char ch: str) {
+        switch(ch) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if(static_cast<unsigned char>(ch) < 0x20u) {
+                out += "\\u00";
+                out += digits[static_cast<unsigned char>(ch) >> 4u];
+                out += digits[static_cast<unsigned char>(ch) & 0xfu];
+            } else {
+                out += ch;
+            }
+        }
+    }
+
+    out += '"';
+}
+
+
+inline bool json_hex(const char *&curr, const char *last, unsigned int &value) noexcept {
+    if(last - curr < 4) {
+        return false;
+    }
+
+    // the input isn't consumed on failure
+    if(const auto result = std::from_chars(curr, curr + 4, value, 16); result.ptr != curr + 4) {
+        return false;
+    }
+
+    curr += 4;
+
+    return true;
+}
+
+
+inline bool json_unescape(const char *&curr, const char *last, std::string &out) {
+    if(curr == last || *curr != '"') {
+        return false;
+    }
+
+    out.clear();
+
+    for(++curr; curr != last && *curr != '"'; ++curr) {
+        if(*curr != '\\') {
+            out += *curr;
+        } else if(++curr == last) {
+            return false;
+        } else {
+            switch(*curr) {
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u': {
+                unsigned int code{};
+
+                if(!json_hex(++curr, last, code)) {
+                    return false;
+                }
+
+                // surrogate pairs encode code points outside of the basic multilingual plane
+                if(code >= 0xd800u && code < 0xdc00u) {
+                    unsigned int low{};
+
+                    if(!json_literal(curr, last, "\\u") || !json_hex(curr, last, low) || low < 0xdc00u || low > 0xdfffu) {
+                        return false;
+                    }
+
+                    code = 0x10000u + ((code - 0xd800u) << 10u) + (low - 0xdc00u);
+                } else if(code >= 0xdc00u && code <= 0xdfffu) {
+                    return false;
+                }
+
+                --curr;
+
+                if(code < 0x80u) {
+                    out += static_cast<char>(code);
+                } else if(code < 0x800u) {
+                    out += static_cast<char>(0xc0u | (code >> 6u));
+                    out += static_cast<char>(0x80u | (code & 0x3fu));
+                } else if(code < 0x10000u) {
+                    out += static_cast<char>(0xe0u | (code >> 12u));
+                    out += static_cast<char>(0x80u | ((code >> 6u) & 0x3fu));
+                    out += static_cast<char>(0x80u | (code & 0x3fu));
+                } else {
+                    out += static_cast<char>(0xf0u | (code >> 18u));
+                    out += static_cast<char>(0x80u | ((code >> 12u) & 0x3fu));
+                    out += static_cast<char>(0x80u | ((code >> 6u) & 0x3fu));
+                    out += static_cast<char>(0x80u | (code & 0x3fu));
+                }
+            } break;
+            default:
+                out += *curr;
+            }
+        }
+    }
+
+    if(curr == last) {
+        return false;
+    }
+
+    ++curr;
+
+    return true;
+}
+
+
+inline bool json_string(const char *&curr, const char *last, std::string &buffer, std::string_view &str) {
+    if(curr == last || *curr != '"') {
+        return false;
+    }
+
+    const auto *first = curr + 1;
+    auto *it = first;
+
+    // strings without escape sequences are returned as they are, without copies
+    while(it != last && *it != '"' && *it != '\\') {
+        ++it;
+    }
+
+    if(it != last && *it == '"') {
+        str = std::string_view{first, static_cast<std::size_t>(it - first)};
+        curr = it + 1;
+        return true;
+    } else if(json_unescape(curr, last, buffer)) {
+        str = buffer;
+        return true;
+    }
+
+    return false;
+}
+
+
+inline bool json_ignore(const char *&curr, const char *last) noexcept {
+    std::size_t depth{};
+
+    do {
+        json_skip(curr, last);
+
+        if(curr == last) {
+            return false;
+        } else if(*curr == '{' || *curr == '[') {
+            ++depth;
+            ++curr;
+        } else if(*curr == '}' || *curr == ']') {
+            if(!depth--) {
+                return false;
+            }
+
+            ++curr;
+        } else if(*curr == ',' || *curr == ':') {
+            if(!depth) {
+                return false;
+            }
+
+            ++curr;
+        } else if(*curr == '"') {
+            for(++curr; curr != last && *curr != '"'; ++curr) {
+                curr += (*curr == '\\' && curr + 1 != last);
+            }
+
+            if(curr == last) {
+                return false;
+            }
+
+            ++curr;
+        } else {
+            const auto *first = curr;
+
+            while(curr != last && *curr != ',' && *curr != ':' && *curr != '}' && *curr != ']' && *curr != ' ' && *curr != '\t' && *curr != '\n' && *curr != '\r') {
+                ++curr;
+            }
+
+            if(first == curr) {
+                return false;
+            }
+        }
+    } while(depth);
+
+    return true;
+}
+
+
+template<typename Type>
+void json_write(std::string &out, const void *instance) {
+    const auto &value = *static_cast<const Type *>(instance);
+
+    if constexpr(std::is_same_v<Type, bool>) {
+        out += value ? "true" : "false";
+    } else if constexpr(std::is_same_v<Type, std::string>) {
+        json_escape(out, value);
+    } else if constexpr(std::is_floating_point_v<Type>) {
+        char buffer[64];
+
+        if(!std::isfinite(value)) {
+            out += "null";
+        } else {
+#if defined(__cpp_lib_to_chars)
+            out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+#else
+            out.append(buffer, static_cast<std::size_t>(std::snprintf(buffer, sizeof(buffer), "%.*Lg", std::numeric_limits<Type>::max_digits10, static_cast<long double>(value))));
+#endif
+        }
+    } else {
+        char buffer[32];
+        out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+    }
+}
+
+
+template<typename Type>
+bool json_read(const char *&curr, const char *last, void *instance) {
+    auto &value = *static_cast<Type *>(instance);
+
+    if constexpr(std::is_same_v<Type, bool>) {
+        if(json_literal(curr, last, "true")) {
+            value = true;
+        } else if(json_literal(curr, last, "false")) {
+            value = false;
+        } else {
+            return false;
+        }
+
+        return true;
+    } else if constexpr(std::is_same_v<Type, std::string>) {
+        return json_unescape(curr, last, value);
+    } else {
+        if(curr != last && *curr == '+') {
+            return false;
+        }
+
+#if defined(__cpp_lib_to_chars)
+        const auto result = std::from_chars(curr, last, value);
+#else
+        std::from_chars_result result{};
+
+        if constexpr(std::is_floating_point_v<Type>) {
+            // the document isn't null-terminated, numbers are parsed from a local copy
+            char buffer[64]{};
+            char *end = buffer;
+            std::copy_n(curr, std::min<std::size_t>(sizeof(buffer) - 1u, static_cast<std::size_t>(last - curr)), buffer);
+            value = static_cast<Type>(std::strtold(buffer, &end));
+            result = { curr + (end - buffer), end == buffer ? std::errc::invalid_argument : std::errc{} };
+        } else {
+            result = std::from_chars(curr, last, value);
+        }
+#endif
+
+        if(result.ec != std::errc{}) {
+            return false;
+        }
+
+        curr = result.ptr;
+        return true;
+    }
+}
+
+
+template<typename Type>
+constexpr json_codec json_codec_of() noexcept {
+    return { &json_write<Type>, &json_read<Type> };
+}
+
+
+template<typename... Type>
+const json_codec * json_leaf(const type_node *node) noexcept {
+    static const std::pair<const type_node *, json_codec> table[]{
+        { &type_info<Type>::node, json_codec_of<Type>() }...
+    };
+
+    for(auto &&curr: table) {
+        if(curr.first == node) {
+            return &curr.second;
+        }
+    }
+
+    return nullptr;
+}
+
+
+inline const json_codec * json_leaf(const type_node *node) noexcept {
+    return json_leaf<
+        bool, char, signed char, unsigned char, short, unsigned short, int, unsigned int,
+        long, unsigned long, long long, unsigned long long, float, double, std::string
+    >(node);
+}
+
+
+struct json_plan {
+    struct field {
+        std::string_view name;
+        std::size_t key;
+        const data_node *data;
+        const type_node *type;
+        const json_codec *codec;
+        std::vector<const base_node *> path;
+    };
+
+    const field * find(const std::string_view name) const noexcept {
+        const auto key = hashed_string::value(name.data(), name.size());
+        const field *elem = nullptr;
+
+        if(mask) {
+            // a perfect hash table has at most one candidate per slot
+            const auto slot = slots[(key >> shift) & mask];
+            elem = slot ? &fields[slot - 1u] : nullptr;
+        } else {
+            auto it = std::find_if(fields.cbegin(), fields.cend(), [key](const auto &curr) { return curr.key == key; });
+            elem = it == fields.cend() ? nullptr : &*it;
+        }
+
+        return (elem && elem->key == key && elem->name == name) ? elem : nullptr;
+    }
+
+    std::vector<field> fields{};
+    std::vector<std::size_t> slots{};
+    std::size_t mask{};
+    std::size_t shift{};
+    bool valid{};
+};
+
+
+inline void json_fields(const type_node *node, std::vector<const base_node *> &path, std::vector<const type_node *> &visited, json_plan &plan) {
+    if(std::find(visited.cbegin(), visited.cend(), node) != visited.cend()) {
+        return;
+    }
+
+    visited.push_back(node);
+
+    for(auto &&curr: schema_fields(node)) {
+        const auto key = hashed_string::value(curr.data->name.data(), curr.data->name.size());
+        const auto shadowed = std::any_of(plan.fields.cbegin(), plan.fields.cend(), [key](const auto &other) { return other.key == key; });
+
+        // unnamed members cannot be encoded, those of the derived classes shadow those of their bases
+        if(!curr.data->name.empty() && !shadowed) {
+            const auto *type = curr.data->ref();
+            plan.fields.push_back({ curr.data->name, key, curr.data, type, json_leaf(type), path });
+        }
+    }
+
+    for(internal::base_node *curr = node->base; curr; curr = curr->next) {
+        path.push_back(curr);
+        json_fields(curr->ref(), path, visited, plan);
+        path.pop_back();
+    }
+}
+
+
+inline json_plan json_layout(const type_node *node) {
+    std::vector<const base_node *> path;
+    std::vector<const type_node *> visited;
+    json_plan plan{};
+
+    json_fields(node, path, visited, plan);
+    plan.valid = !plan.fields.empty();
+
+    const auto count = plan.fields.size();
+    std::size_t size = 1u;
+
+    while(size < count) {
+        size <<= 1u;
+    }
+
+    // looks for a size and a shift such that all the keys end up in different slots
+    for(const auto limit = size << 6u; !plan.mask && count > 1u && size <= limit; size <<= 1u) {
+        for(std::size_t shift{}; !plan.mask && shift < sizeof(std::size_t) * 8u; ++shift) {
+            plan.slots.assign(size, 0u);
+            std::size_t pos{};
+
+            for(; pos < count; ++pos) {
+                if(auto &slot = plan.slots[(plan.fields[pos].key >> shift) & (size - 1u)]; !slot) {
+                    slot = pos + 1u;
+                } else {
+                    break;
+                }
+            }
+
+            if(pos == count) {
+                plan.mask = size - 1u;
+                plan.shift = shift;
+            }
+        }
+    }
+
+    return plan;
+}
+
+
+class json_cache {
+public:
+    const json_plan & plan(const type_node *node) {
+        if(const auto curr = lookup_cache::generation(); curr != generation) {
+            plans.clear();
+            generation = curr;
+        }
+
+        if(auto it = plans.find(node); it != plans.end()) {
+            return it->second;
+        }
+
+        return plans.emplace(node, json_layout(node)).first->second;
+    }
+
+private:
+    std::unordered_map<const type_node *, json_plan> plans{};
+    std::size_t generation{};
+};
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief Streaming JSON writer driven by the meta data of the reflected types.
+ *
+ * Reflected types are written as objects, one member per named meta data,
+ * while booleans, arithmetic types and strings are written as they are.<br/>
+ * Members registered as pointers to data members are read directly from the
+ * objects, setter/getter pairs are the only ones that go through their
+ * getters.
+ *
+ * Arrays are written one element at a time. The output can be taken and
+ * cleared at any time between two values, so that the amount of memory in use
+ * doesn't depend on the number of elements.
+ *
+ * @warning
+ * A writer isn't thread safe and registering or unregistering types
+ * invalidates all its compiled plans.
+ */
+class json_writer {
+    void separate() {
+        if(!arrays.empty()) {
+            if(arrays.back()) {
+                buffer += ',';
+            }
+
+            arrays.back() = true;
+        }
+    }
+
+    bool write(const internal::type_node *node, const void *instance) {
+        if(const auto *codec = internal::json_leaf(node); codec) {
+            codec->write(buffer, instance);
+            return true;
+        } else if(const auto &plan = cache.plan(node); plan.valid) {
+            buffer += '{';
+
+            for(auto &&curr: plan.fields) {
+                auto *ptr = const_cast<void *>(instance);
+
+                for(auto *base: curr.path) {
+                    ptr = base->cast(ptr);
+                }
+
+                any value{};
+                const void *elem = curr.data->address ? curr.data->address(ptr) : nullptr;
+
+                if(!curr.data->address) {
+                    handle parent{};
+                    parent.node = curr.data->parent;
+                    parent.instance = ptr;
+                    value = curr.data->get(parent, {});
+                    elem = handle{value}.instance;
+                }
+
+                if(&curr != plan.fields.data()) {
+                    buffer += ',';
+                }
+
+                internal::json_escape(buffer, curr.name);
+                buffer += ':';
+
+                if(!elem || !(curr.codec ? (curr.codec->write(buffer, elem), true) : write(curr.type, elem))) {
+                    return false;
+                }
+            }
+
+            buffer += '}';
+            return true;
+        }
+
+        return false;
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Writes an object.
+     *
+     * The output is left untouched if the object cannot be written.
+     *
+     * @param handle A handle to the object to write.
+     * @return True in case of success, false otherwise.
+     */
+    bool write(handle handle) {
+        const auto size = buffer.size();
+        const auto first = arrays.empty() || arrays.back();
+        separate();
+
+        if(!handle || !write(handle.node, handle.instance)) {
+            buffer.resize(size);
+
+            if(!arrays.empty()) {
+                arrays.back() = first;
+            }
+
+            return false;
+        }
+
+        return true;
+    }
+
+    /*! @brief Opens an array, values are written as its elements. */
+    void begin_array() {
+        separate();
+        buffer += '[';
+        arrays.push_back(false);
+    }
+
+    /*! @brief Closes the last array opened. */
+    void end_array() {
+        assert(!arrays.empty());
+        buffer += ']';
+        arrays.pop_back();
+    }
+
+    /**
+     * @brief Returns the output written so far.
+     * @return The output written so far.
+     */
+    std::string_view str() const noexcept {
+        return buffer;
+    }
+
+    /*! @brief Clears the output, open arrays and compiled plans are kept. */
+    void clear() noexcept {
+        buffer.clear();
+    }
+
+private:
+    std::string buffer{};
+    std::vector<bool> arrays{};
+    internal::json_cache cache{};
+};
+
+
+/**
+ * @brief JSON reader driven by the meta data of the reflected types.
+ *
+ * A reader decodes values straight into existing objects, without building
+ * any intermediate representation of the document. Unlike the writer, it
+ * doesn't stream: the whole document must be available as a contiguous
+ * sequence of characters when the reader is constructed. Keys are matched against
+ * the names of the meta data by means of a perfect hash table built once per
+ * type, unknown keys are skipped as well as null values.<br/>
+ * Members registered as pointers to data members are written directly,
+ * setter/getter pairs are the only ones that go through their setters.
+ *
+ * Arrays are read one element at a time, so that no memory is allocated for
+ * the elements other than the instance they are decoded into.
+ *
+ * @warning
+ * A reader doesn't own the document. Therefore, the latter must outlive the
+ * former.<br/>
+ * A reader isn't thread safe and registering or unregistering types
+ * invalidates all its compiled plans.
+ */
+class json_reader {
+    bool read(const internal::json_plan::field &field, void *instance) {
+        for(auto *base: field.path) {
+            instance = base->cast(instance);
+        }
+
+        handle parent{};
+        any value{};
+        void *elem = field.data->address ? field.data->address(instance) : nullptr;
+
+        if(!field.data->address) {
+            parent.node = field.data->parent;
+            parent.instance = instance;
+            value = field.data->get(parent, {});
+            elem = handle{value}.instance;
+        }
+
+        if(!elem || !(field.codec ? field.codec->read(curr, last, elem) : read(field.type, elem))) {
+            return false;
+        }
+
+        return value ? field.data->set(parent, {}, std::move(value)) : true;
+    }
+
+    bool read(const internal::type_node *node, void *instance) {
+        internal::json_skip(curr, last);
+
+        if(const auto *codec = internal::json_leaf(node); codec) {
+            return codec->read(curr, last, instance);
+        } else if(const auto &plan = cache.plan(node); plan.valid && curr != last && *curr == '{') {
+            internal::json_skip(++curr, last);
+
+            for(bool first = true; curr != last && *curr != '}'; first = false) {
+                std::string_view key{};
+
+                if((!first && *(curr++) != ',') || (internal::json_skip(curr, last), !internal::json_string(curr, last, scratch, key))) {
+                    return false;
+                }
+
+                internal::json_skip(curr, last);
+
+                if(curr == last || *(curr++) != ':') {
+                    return false;
+                }
+
+                internal::json_skip(curr, last);
+
+                if(const auto *field = plan.find(key); !field || internal::json_literal(curr, last, "null")) {
+                    if(!field && !internal::json_ignore(curr, last)) {
+                        return false;
+                    }
+                } else if(!read(*field, instance)) {
+                    return false;
+                }
+
+                internal::json_skip(curr, last);
+            }
+
+            if(curr == last) {
+                return false;
+            }
+
+            ++curr;
+            return true;
+        }
+
+        return false;
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructs a reader for a given document.
+     * @param text The document to read.
+     */
+    explicit json_reader(const std::string_view text) noexcept
+        : curr{text.data()},
+          last{text.data() + text.size()},
+          first{}
+    {}
+
+    /**
+     * @brief Decodes the next value into an existing instance.
+     *
+     * The position in the document is left untouched if the value cannot be
+     * decoded. The instance may have been partially modified in this case.
+     *
+     * @param handle A handle to the object to decode into.
+     * @return True in case of success, false otherwise.
+     */
+    bool read(handle handle) {
+        const auto *prev = curr;
+
+        if(!handle || !read(handle.node, handle.instance)) {
+            curr = prev;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Opens an array.
+     * @return True if the next value is an array, false otherwise.
+     */
+    bool begin_array() noexcept {
+        internal::json_skip(curr, last);
+
+        if(curr != last && *curr == '[') {
+            ++curr;
+            first = true;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Moves to the next element of the array opened last.
+     * @return True if there is another element to read, false at the end of
+     * the array.
+     */
+    bool next() noexcept {
+        internal::json_skip(curr, last);
+
+        if(curr != last && *curr == ']') {
+            ++curr;
+            return false;
+        } else if(std::exchange(first, false)) {
+            return curr != last;
+        } else if(curr != last && *curr == ',') {
+            ++curr;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Skips the next value.
+     * @return True in case of success, false otherwise.
+     */
+    bool skip() noexcept {
+        const auto *prev = curr;
+        first = false;
+
+        if(!internal::json_ignore(curr, last)) {
+            curr = prev;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of characters not yet read.
+     * @return The number of characters not yet read.
+     */
+    size_type size() const noexcept {
+        return static_cast<size_type>(last - curr);
+    }
+
+private:
+    const char *curr;
+    const char *last;
+    bool first;
+    std::string scratch{};
+    internal::json_cache cache{};
+};
+
+
+}
+
+
+#endif // META_JSON_HPP
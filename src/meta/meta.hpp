@@ -2,18 +2,33 @@
 #define META_META_HPP
 
 
+#include <new>
 #include <array>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 #include <cstring>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
+#include <typeinfo>
+#include <typeindex>
+#include <algorithm>
+#include <functional>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <cassert>
+#include "config.hpp"
+#include "hashed_string.hpp"
 
 
 namespace meta {
 
 
+class context;
 class any;
 class handle;
 class prop;
@@ -25,6 +40,79 @@ class data;
 class func;
 class type;
 
+template<typename, std::size_t>
+class inline_cache;
+
+class serializer;
+class deserializer;
+class flat_writer;
+class flat_view;
+class json_writer;
+class json_reader;
+
+
+/*! @brief Traits of a meta type, packed in a bitmask. */
+enum class traits: std::uint32_t {
+    /*! @brief No traits. */
+    none = 0u,
+    /*! @brief The underlying type is void. */
+    is_void = 1u << 0u,
+    /*! @brief The underlying type is an integral type. */
+    is_integral = 1u << 1u,
+    /*! @brief The underlying type is a floating-point type. */
+    is_floating_point = 1u << 2u,
+    /*! @brief The underlying type is an array type. */
+    is_array = 1u << 3u,
+    /*! @brief The underlying type is an enum. */
+    is_enum = 1u << 4u,
+    /*! @brief The underlying type is an union. */
+    is_union = 1u << 5u,
+    /*! @brief The underlying type is a class. */
+    is_class = 1u << 6u,
+    /*! @brief The underlying type is a pointer. */
+    is_pointer = 1u << 7u,
+    /*! @brief The underlying type is a function pointer. */
+    is_function_pointer = 1u << 8u,
+    /*! @brief The underlying type is a pointer to data member. */
+    is_member_object_pointer = 1u << 9u,
+    /*! @brief The underlying type is a pointer to member function. */
+    is_member_function_pointer = 1u << 10u,
+    /*! @brief The underlying type is trivially copyable. */
+    is_trivially_copyable = 1u << 11u
+};
+
+
+/**
+ * @brief Combines two masks of traits.
+ * @param lhs A valid mask of traits.
+ * @param rhs A valid mask of traits.
+ * @return The union of the two masks.
+ */
+constexpr traits operator|(const traits lhs, const traits rhs) noexcept {
+    return traits{static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs)};
+}
+
+
+/**
+ * @brief Intersects two masks of traits.
+ * @param lhs A valid mask of traits.
+ * @param rhs A valid mask of traits.
+ * @return The intersection of the two masks.
+ */
+constexpr traits operator&(const traits lhs, const traits rhs) noexcept {
+    return traits{static_cast<std::uint32_t>(lhs) & static_cast<std::uint32_t>(rhs)};
+}
+
+
+/**
+ * @brief Complements a mask of traits.
+ * @param mask A valid mask of traits.
+ * @return The complement of the given mask.
+ */
+constexpr traits operator~(const traits mask) noexcept {
+    return traits{~static_cast<std::uint32_t>(mask)};
+}
+
 
 /**
  * @cond TURN_OFF_DOXYGEN
@@ -36,30 +124,98 @@ namespace internal {
 
 
 struct type_node;
+struct prop_node;
+struct frozen_node;
+struct delta_codec;
+
+
+// pointers read without locks while types are registered and unregistered, loads acquire and stores release
+template<typename Node>
+struct link {
+    using type = Node;
+
+    constexpr link(Node *node = nullptr) noexcept
+        : value{node}
+    {}
+
+    link(const link &) = delete;
+
+    link & operator=(const link &other) noexcept {
+        return (*this = static_cast<Node *>(other));
+    }
+
+    link & operator=(Node *node) noexcept {
+        value.store(node, std::memory_order_release);
+        return *this;
+    }
+
+    operator Node *() const noexcept {
+        return value.load(std::memory_order_acquire);
+    }
+
+    Node * operator->() const noexcept {
+        return value.load(std::memory_order_acquire);
+    }
+
+    Node * exchange(Node *node) noexcept {
+        return value.exchange(node, std::memory_order_acq_rel);
+    }
+
+    std::atomic<Node *> value;
+};
+
+
+struct context_node {
+    ~context_node() noexcept;
+
+    void thaw() noexcept;
+
+    link<type_node> type{nullptr};
+    // properties by kind of meta object and hash of their keys, one list per distinct key
+    std::unordered_map<std::size_t, std::vector<prop_node *>> tags[4u]{};
+    mutable std::mutex tag_mutex{};
+    std::atomic<frozen_node *> frozen{nullptr};
+    std::unique_ptr<frozen_node> retired{};
+
+    static context_node & from(context &) noexcept;
+    static const context_node & from(const context &) noexcept;
+};
 
 
 struct prop_node {
-    prop_node * next;
+    link<prop_node> next;
     any(* const key)();
     any(* const value)();
+    any(* const key_ref)() noexcept;
+    any(* const value_ref)() noexcept;
     prop(* const clazz)() noexcept;
+    type_node * const key_type;
+    const void * const key_data;
+    std::size_t key_hash;
+    link<prop_node> tag{nullptr};
+    void(* owner)(){nullptr};
+    context_node * ctx{nullptr};
 };
 
 
 struct base_node {
     base_node ** const underlying;
     type_node * const parent;
-    base_node * next;
+    link<base_node> next;
     type_node *(* const ref)() noexcept;
+    type_node * const type;
     void *(* const cast)(void *) noexcept;
+    void *(* const downcast)(void *) noexcept;
     base(* const clazz)() noexcept;
+    std::size_t offset{};
+    bool fixed{};
 };
 
 
 struct conv_node {
     conv_node ** const underlying;
     type_node * const parent;
-    conv_node * next;
+    link<conv_node> next;
     type_node *(* const ref)() noexcept;
     any(* const convert)(const void *);
     conv(* const clazz)() noexcept;
@@ -70,8 +226,8 @@ struct ctor_node {
     using size_type = std::size_t;
     ctor_node ** const underlying;
     type_node * const parent;
-    ctor_node * next;
-    prop_node * prop;
+    link<ctor_node> next;
+    link<prop_node> prop;
     const size_type size;
     type_node *(* const arg)(size_type) noexcept;
     any(* const invoke)(any * const);
@@ -91,14 +247,17 @@ struct data_node {
     data_node ** const underlying;
     std::size_t identifier;
     type_node * const parent;
-    data_node * next;
-    prop_node * prop;
+    link<data_node> next;
+    link<prop_node> prop;
     const bool is_const;
     const bool is_static;
     type_node *(* const ref)() noexcept;
     bool(* const set)(handle, any, any);
     any(* const get)(handle, any);
     data(* const clazz)() noexcept;
+    std::string_view name{};
+    void *(* const address)(void *) noexcept{nullptr};
+    std::size_t offset{};
 };
 
 
@@ -107,8 +266,8 @@ struct func_node {
     func_node ** const underlying;
     std::size_t identifier;
     type_node * const parent;
-    func_node * next;
-    prop_node * prop;
+    link<func_node> next;
+    link<prop_node> prop;
     const size_type size;
     const bool is_const;
     const bool is_static;
@@ -116,47 +275,133 @@ struct func_node {
     type_node *(* const arg)(size_type) noexcept;
     any(* const invoke)(handle, any *);
     func(* const clazz)() noexcept;
+    std::string_view name{};
+};
+
+
+struct frozen_node {
+    using size_type = std::size_t;
+
+    static constexpr size_type alignment = 64u;
+
+    struct record {
+        const frozen_node *arena;
+        size_type index;
+    };
+
+    struct entry {
+        size_type row;
+        const func_node *func;
+    };
+
+    struct hash {
+        size_type bucket_shift;
+        size_type slot_shift;
+        size_type pilot;
+        size_type slot;
+    };
+
+    static constexpr std::uint64_t bucket_multiplier = 0x9E3779B97F4A7C15ull;
+    static constexpr std::uint64_t slot_multiplier = 0xC2B2AE3D27D4EB4Full;
+
+    explicit frozen_node(const size_type bytes)
+        : storage{::operator new(bytes, std::align_val_t{alignment})}
+    {}
+
+    frozen_node(const frozen_node &) = delete;
+
+    ~frozen_node() noexcept {
+        ::operator delete(storage, std::align_val_t{alignment});
+    }
+
+    frozen_node & operator=(const frozen_node &) = delete;
+
+    // one multiply-shift to pick the bucket, one to pick the slot, one compare to verify
+    size_type lookup(const hash &params, const size_type *identifier, const size_type count, const size_type key) const noexcept {
+        auto pos = count;
+
+        if(params.bucket_shift) {
+            const auto bucket = (std::uint64_t{key} * bucket_multiplier) >> params.bucket_shift;
+            const auto candidate = slot[params.slot + (((std::uint64_t{key} ^ pilot[params.pilot + bucket]) * slot_multiplier) >> params.slot_shift)];
+            pos = (identifier[candidate] == key) ? candidate : count;
+        } else {
+            for(pos = {}; pos < count && identifier[pos] != key; ++pos);
+        }
+
+        return pos;
+    }
+
+    std::unique_ptr<frozen_node> retired{};
+    void * const storage;
+    size_type size{};
+    hash type_hash{};
+    size_type *type_identifier{};
+    type_node **type{};
+    record *records{};
+    size_type *data_range{};
+    hash *data_hash{};
+    size_type *data_identifier{};
+    const data_node **data{};
+    size_type *func_range{};
+    hash *func_hash{};
+    size_type *func_identifier{};
+    const func_node **func{};
+    std::uint64_t *pilot{};
+    size_type *slot{};
+    size_type base_words{};
+    size_type *base_index{};
+    bool *closed{};
+    std::uint64_t *bases{};
+    size_type dispatch_size{};
+    size_type *dispatch_offset{};
+    entry *dispatch{};
+    size_type *flat_data_range{};
+    const data_node **flat_data{};
+    size_type *flat_func_range{};
+    const func_node **flat_func{};
 };
 
 
 struct type_node {
     using size_type = std::size_t;
     std::size_t identifier;
-    type_node * next;
-    prop_node * prop;
-    const bool is_void;
-    const bool is_integral;
-    const bool is_floating_point;
-    const bool is_array;
-    const bool is_enum;
-    const bool is_union;
-    const bool is_class;
-    const bool is_pointer;
-    const bool is_function_pointer;
-    const bool is_member_object_pointer;
-    const bool is_member_function_pointer;
+    link<type_node> next;
+    link<prop_node> prop;
+    const meta::traits traits;
     const size_type extent;
+    const size_type size;
+    const bool unique;
     bool(* const compare)(const void *, const void *);
+    std::size_t(* const hash)(const void *);
     type(* const remove_pointer)() noexcept;
     type(* const clazz)() noexcept;
-    base_node *base{nullptr};
-    conv_node *conv{nullptr};
-    ctor_node *ctor{nullptr};
-    dtor_node *dtor{nullptr};
-    data_node *data{nullptr};
-    func_node *func{nullptr};
+    const void *(* const dynamic)(const void *, const type_node *&) noexcept;
+    link<base_node> base{nullptr};
+    link<conv_node> conv{nullptr};
+    link<ctor_node> ctor{nullptr};
+    link<dtor_node> dtor{nullptr};
+    link<data_node> data{nullptr};
+    link<func_node> func{nullptr};
+    link<context_node> ctx{nullptr};
+    bool(* unregister)(){nullptr};
+    std::atomic<void(*)() noexcept> pending{nullptr};
+    std::atomic<const frozen_node::record *> frozen{nullptr};
+    std::string_view name{};
 };
 
 
 template<typename...>
 struct info_node {
-    inline static type_node *type = nullptr;
+    inline static context_node ctx{};
+    inline static std::recursive_mutex mutex{};
 };
 
 
 template<typename Type>
 struct info_node<Type> {
-    inline static type_node *type = nullptr;
+    inline static link<type_node> type{nullptr};
+
+    static type_node node;
 
     template<typename>
     inline static base_node *base = nullptr;
@@ -193,16 +438,133 @@ void iterate(Op op, const Node *curr) noexcept {
 }
 
 
+template<typename Op, typename Node>
+void iterate(Op op, const link<Node> &head) noexcept {
+    iterate(op, static_cast<const Node *>(head));
+}
+
+
+template<typename Node>
+struct frozen_view {
+    const frozen_node *arena;
+    const frozen_node::hash *hash;
+    const std::size_t *identifier;
+    const Node * const *first;
+    const Node * const *last;
+};
+
+
+template<auto Member>
+auto frozen_members(const type_node *node) noexcept {
+    using node_type = typename std::decay_t<decltype(node->*Member)>::type;
+    frozen_view<node_type> view{};
+
+    if constexpr(std::is_same_v<node_type, data_node> || std::is_same_v<node_type, func_node>) {
+        if(const auto *record = node->frozen.load(std::memory_order_acquire); record) {
+            const auto &arena = *record->arena;
+
+            if constexpr(std::is_same_v<node_type, data_node>) {
+                const auto first = arena.data_range[record->index];
+                view = { &arena, arena.data_hash + record->index, arena.data_identifier + first, arena.data + first, arena.data + arena.data_range[record->index + 1u] };
+            } else {
+                const auto first = arena.func_range[record->index];
+                view = { &arena, arena.func_hash + record->index, arena.func_identifier + first, arena.func + first, arena.func + arena.func_range[record->index + 1u] };
+            }
+        }
+    }
+
+    return view;
+}
+
+
+template<typename Node>
+struct flat_view {
+    const Node * const *first;
+    const Node * const *last;
+};
+
+
+template<auto Member>
+auto flat_members(const type_node *node) noexcept {
+    using node_type = typename std::decay_t<decltype(node->*Member)>::type;
+    flat_view<node_type> view{};
+
+    if constexpr(std::is_same_v<node_type, data_node> || std::is_same_v<node_type, func_node>) {
+        // the list is complete only if the arena knows the whole hierarchy
+        if(const auto *record = node ? node->frozen.load(std::memory_order_acquire) : nullptr; record && record->arena->closed[record->index]) {
+            const auto &arena = *record->arena;
+
+            if constexpr(std::is_same_v<node_type, data_node>) {
+                view = { arena.flat_data + arena.flat_data_range[record->index], arena.flat_data + arena.flat_data_range[record->index + 1u] };
+            } else {
+                view = { arena.flat_func + arena.flat_func_range[record->index], arena.flat_func + arena.flat_func_range[record->index + 1u] };
+            }
+        }
+    }
+
+    return view;
+}
+
+
+struct walk_frame {
+    const walk_frame *parent;
+    const base_node *first;
+    const base_node *curr;
+};
+
+
+inline bool reaches(const type_node *node, const type_node *target) noexcept {
+    bool ret = (node == target);
+
+    for(base_node *curr = node->base; curr && !ret; curr = curr->next) {
+        ret = reaches(curr->ref(), target);
+    }
+
+    return ret;
+}
+
+
+inline bool visited(const walk_frame *frame, const type_node *target) noexcept {
+    bool ret{};
+
+    // a base was already visited if it's reachable through any of the bases walked so far
+    for(; frame && !ret; frame = frame->parent) {
+        for(auto *curr = frame->first; curr != frame->curr && !ret; curr = curr->next) {
+            ret = reaches(curr->ref(), target);
+        }
+    }
+
+    return ret;
+}
+
+
 template<auto Member, typename Op>
-void iterate(Op op, const type_node *node) noexcept {
-    if(node) {
-        auto *curr = node->base;
+void iterate(Op &op, const type_node *node, const walk_frame *parent) noexcept {
+    if(const auto view = frozen_members<Member>(node); view.first) {
+        for(auto *it = view.first; it != view.last; ++it) {
+            op(*it);
+        }
+    } else {
         iterate(op, node->*Member);
+    }
 
-        while(curr) {
-            iterate<Member>(op, curr->ref());
-            curr = curr->next;
+    // bases shared by multiple paths (diamonds) are visited only once
+    for(walk_frame frame{parent, node->base, node->base}; frame.curr; frame.curr = frame.curr->next) {
+        if(auto *type = frame.curr->ref(); !visited(&frame, type)) {
+            iterate<Member>(op, type, &frame);
+        }
+    }
+}
+
+
+template<auto Member, typename Op>
+void iterate(Op op, const type_node *node) noexcept {
+    if(const auto view = flat_members<Member>(node); view.first) {
+        for(auto *it = view.first; it != view.last; ++it) {
+            op(*it);
         }
+    } else if(node) {
+        iterate<Member>(op, node, nullptr);
     }
 }
 
@@ -217,14 +579,73 @@ auto find_if(Op op, const Node *curr) noexcept {
 }
 
 
+template<typename Op, typename Node>
+auto find_if(Op op, const link<Node> &head) noexcept {
+    return find_if(op, static_cast<const Node *>(head));
+}
+
+
+template<typename Type>
+std::size_t prop_hash([[maybe_unused]] const Type &key) noexcept {
+    if constexpr(!std::is_same_v<Type, std::decay_t<Type>>) {
+        // arrays decay to pointers, as they do when stored as keys
+        return prop_hash<std::decay_t<const Type>>(key);
+    } else if constexpr(std::is_integral_v<Type> || std::is_enum_v<Type>) {
+        return static_cast<std::size_t>(key);
+    } else if constexpr(std::is_default_constructible_v<std::hash<Type>>) {
+        return std::hash<Type>{}(key);
+    } else {
+        return {};
+    }
+}
+
+
+template<typename Key>
+auto match_key(const Key &key) noexcept {
+    if constexpr(!std::is_same_v<Key, std::decay_t<Key>>) {
+        using key_type = std::decay_t<const Key>;
+
+        // decayed keys are temporaries, they are kept by copy
+        return [value = static_cast<key_type>(key), hash = prop_hash(key)](const prop_node *candidate) {
+            return candidate->key_hash == hash
+                    && candidate->key_type == &type_info<key_type>::node
+                    && candidate->key_type->compare(candidate->key_data, &value);
+        };
+    } else {
+        // the hash rules out most of the candidates, the keys are compared only in case of match
+        return [&key, hash = prop_hash(key)](const prop_node *candidate) {
+            return candidate->key_hash == hash
+                    && candidate->key_type == &type_info<Key>::node
+                    && candidate->key_type->compare(candidate->key_data, &key);
+        };
+    }
+}
+
+
+inline const type_node * realize(const type_node *node) noexcept {
+    if(auto *pending = node->pending.load(std::memory_order_acquire); pending) {
+        pending();
+    }
+
+    return node;
+}
+
+
 template<auto Member, typename Op>
 auto find_if(Op op, const type_node *node) noexcept
 -> decltype(find_if(op, node->*Member)) {
     decltype(find_if(op, node->*Member)) ret = nullptr;
 
     if(node) {
-        ret = find_if(op, node->*Member);
-        auto *curr = node->base;
+        if(const auto view = frozen_members<Member>(node); view.first) {
+            for(auto *it = view.first; it != view.last && !ret; ++it) {
+                ret = op(*it) ? *it : nullptr;
+            }
+        } else {
+            ret = find_if(op, node->*Member);
+        }
+
+        base_node *curr = node->base;
 
         while(curr && !ret) {
             ret = find_if<Member>(op, curr->ref());
@@ -236,30 +657,398 @@ auto find_if(Op op, const type_node *node) noexcept
 }
 
 
-template<typename Type>
-const Type * try_cast(const type_node *node, void *instance) noexcept {
-    const auto *type = type_info<Type>::resolve();
+template<auto Member>
+auto find(const std::size_t identifier, const type_node *node) noexcept
+-> const typename std::decay_t<decltype(node->*Member)>::type * {
+    const typename std::decay_t<decltype(node->*Member)>::type *ret = nullptr;
+
+    if(node) {
+        if(const auto view = frozen_members<Member>(node); view.first) {
+            const auto count = static_cast<std::size_t>(view.last - view.first);
+            const auto pos = view.arena->lookup(*view.hash, view.identifier, count, identifier);
+            ret = (pos == count) ? nullptr : view.first[pos];
+        } else {
+            ret = find_if([identifier](auto *candidate) {
+                return candidate->identifier == identifier;
+            }, node->*Member);
+        }
+
+        base_node *curr = node->base;
+
+        while(curr && !ret) {
+            ret = find<Member>(identifier, curr->ref());
+            curr = curr->next;
+        }
+    }
+
+    return ret;
+}
+
+
+struct epoch {
+    using size_type = std::size_t;
+
+    static size_type enter() noexcept {
+        auto curr = current.load();
+        readers[curr % 2].fetch_add(1);
+
+        // an ongoing synchronization could have missed us, try again
+        while(current.load() != curr) {
+            readers[curr % 2].fetch_sub(1);
+            curr = current.load();
+            readers[curr % 2].fetch_add(1);
+        }
+
+        ++depth;
+        return curr;
+    }
+
+    static void leave(const size_type curr) noexcept {
+        --depth;
+        readers[curr % 2].fetch_sub(1);
+    }
+
+    static void synchronize() noexcept {
+        // waiting for ourselves would never end
+        assert(!depth);
+
+        // synchronizations don't overlap, unlike a mutex the flag never throws
+        while(busy.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        const auto prev = current.fetch_add(1);
+
+        while(readers[prev % 2].load()) {
+            std::this_thread::yield();
+        }
+
+        busy.clear(std::memory_order_release);
+    }
+
+    inline static std::atomic<size_type> current{};
+    inline static std::atomic<size_type> readers[2]{};
+    inline static thread_local size_type depth{};
+    inline static std::atomic_flag busy = ATOMIC_FLAG_INIT;
+};
+
+
+inline context_node::~context_node() noexcept {
+    thaw();
+
+    if(retired) {
+        epoch::synchronize();
+    }
+}
+
+
+inline void context_node::thaw() noexcept {
+    if(auto *arena = frozen.exchange(nullptr, std::memory_order_acq_rel); arena) {
+        for(std::size_t pos{}; pos < arena->size; ++pos) {
+            // types unregistered meanwhile could belong to another arena by now
+            const frozen_node::record *record = arena->records + pos;
+            arena->type[pos]->frozen.compare_exchange_strong(record, nullptr, std::memory_order_acq_rel);
+        }
+
+        // readers can still walk the arena, it's released by the next freeze
+        arena->retired = std::move(retired);
+        retired.reset(arena);
+    }
+}
+
+
+struct lookup_cache {
+    using size_type = std::size_t;
+
+    static_assert((META_LOOKUP_CACHE_SIZE & (META_LOOKUP_CACHE_SIZE - 1)) == 0);
+
+    struct entry {
+        size_type generation;
+        const void *scope;
+        size_type key;
+        const void *value;
+    };
+
+    static size_type generation() noexcept {
+        return counter.load(std::memory_order_acquire);
+    }
+
+    static void invalidate() noexcept {
+        counter.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    template<auto Member, typename Op>
+    static auto find(const void *scope, const size_type key, Op op) noexcept {
+        if constexpr(META_LOOKUP_CACHE_SIZE == 0) {
+            return op();
+        } else {
+            // the generation must be read before the lookup, mutations may happen in between
+            const auto curr = generation();
+            auto &elem = table<Member>[(key ^ (reinterpret_cast<std::uintptr_t>(scope) >> 4)) & (META_LOOKUP_CACHE_SIZE - 1)];
+
+            if(elem.generation != curr || elem.scope != scope || elem.key != key) {
+                elem = { curr, scope, key, op() };
+            }
+
+            return static_cast<decltype(op())>(elem.value);
+        }
+    }
+
+    inline static std::atomic<size_type> counter{1u};
+
+    template<auto>
+    inline static thread_local entry table[META_LOOKUP_CACHE_SIZE ? META_LOOKUP_CACHE_SIZE : 1]{};
+};
+
+
+// answers from the transitive closure of the bases if the arena knows all of them
+inline bool frozen_derived(const type_node *node, const type_node *base, bool &derived) noexcept {
+    const auto *lhs = node ? node->frozen.load(std::memory_order_acquire) : nullptr;
+    const bool known = lhs && lhs->arena->closed[lhs->index];
+
+    if(known) {
+        const auto &arena = *lhs->arena;
+        const auto *rhs = base->frozen.load(std::memory_order_acquire);
+        const auto column = (rhs && rhs->arena == &arena) ? arena.base_index[rhs->index] : arena.size;
+        derived = (column != arena.size) && ((arena.bases[lhs->index * arena.base_words + column / 64u] >> (column % 64u)) & 1u);
+    }
+
+    return known;
+}
+
+
+inline bool derived_from(const type_node *node, const type_node *base) noexcept {
+    bool derived{};
+
+    if(!frozen_derived(node, base, derived)) {
+        derived = find_if<&type_node::base>([base](auto *candidate) {
+            return candidate->ref() == base;
+        }, node);
+    }
+
+    return derived;
+}
+
+
+struct schema_field {
+    const data_node *data;
+    std::size_t offset;
+};
+
+
+inline std::vector<schema_field> schema_fields(const type_node *node) {
+    std::vector<schema_field> fields{};
+
+    for(data_node *curr = node->data; curr; curr = curr->next) {
+        if(!curr->is_static && !curr->is_const) {
+            fields.push_back({ curr, curr->address ? curr->offset : std::size_t{} });
+        }
+    }
+
+    // members with an address come first in memory order, the others are sorted by identifier
+    std::sort(fields.begin(), fields.end(), [](const auto &lhs, const auto &rhs) {
+        const bool lhs_accessor = !lhs.data->address;
+        const bool rhs_accessor = !rhs.data->address;
+
+        if(lhs_accessor != rhs_accessor) {
+            return rhs_accessor;
+        }
+
+        return lhs.offset == rhs.offset ? (lhs.data->identifier < rhs.data->identifier) : (lhs.offset < rhs.offset);
+    });
+
+    return fields;
+}
+
+
+struct schema_cache {
+    std::size_t generation{};
+    std::unordered_map<const type_node *, std::size_t> hash{};
+};
+
+
+inline std::size_t schema_hash(const type_node *node) {
+    using traits_type = fnv1a_traits<sizeof(std::size_t)>;
+    thread_local schema_cache cache{};
+
+    // hashes are computed once per type and generation, nested types are shared among their parents
+    if(const auto curr = lookup_cache::generation(); cache.generation != curr) {
+        cache.hash.clear();
+        cache.generation = curr;
+    } else if(const auto it = cache.hash.find(node); it != cache.hash.cend()) {
+        return it->second;
+    }
+
+    const auto generation = cache.generation;
+    auto partial{traits_type::offset};
+
+    const auto combine = [&partial](const std::size_t value) {
+        partial = (partial ^ value) * traits_type::prime;
+    };
+
+    combine(node->identifier);
+    combine(static_cast<std::size_t>(node->traits));
+    combine(node->size);
+
+    for(auto &&curr: schema_fields(node)) {
+        combine(curr.data->identifier);
+        combine(schema_hash(curr.data->ref()));
+        combine(curr.data->address ? curr.offset : node->size);
+    }
+
+    for(base_node *curr = node->base; curr; curr = curr->next) {
+        combine(schema_hash(curr->ref()));
+    }
+
+    // types registered meanwhile make the result stale, it's returned but not cached
+    if(cache.generation == generation) {
+        cache.hash.emplace(node, static_cast<std::size_t>(partial));
+    }
+
+    return static_cast<std::size_t>(partial);
+}
+
+
+struct dynamic_cache {
+    using size_type = std::size_t;
+    using registry_type = std::unordered_map<std::type_index, const type_node *>;
+
+    static constexpr size_type size = 32u;
+
+    struct entry {
+        size_type generation;
+        const std::type_info *info;
+        const type_node *node;
+    };
+
+    static const type_node * find(const std::type_info &info) noexcept {
+        thread_local entry table[size]{};
+
+        // the generation must be read before the lookup, mutations may happen in between
+        const auto curr = lookup_cache::generation();
+        auto &elem = table[(reinterpret_cast<std::uintptr_t>(&info) >> 4) & (size - 1u)];
+
+        if(elem.generation != curr || elem.info != &info) {
+            // snapshots are immutable, they are searched without the global mutex
+            const auto snapshot = std::atomic_load_explicit(&registry, std::memory_order_acquire);
+            const auto match = snapshot ? snapshot->find(info) : registry_type::const_iterator{};
+            elem = { curr, &info, (snapshot && match != snapshot->cend()) ? match->second : nullptr };
+        }
+
+        return elem.node;
+    }
+
+    static void update(const std::type_info &info, const type_node *node) {
+        // writers are serialized by the global mutex, readers keep the snapshot they loaded
+        std::lock_guard<std::recursive_mutex> guard{type_info<>::mutex};
+        const auto prev = std::atomic_load_explicit(&registry, std::memory_order_relaxed);
+        auto next = prev ? std::make_shared<registry_type>(*prev) : std::make_shared<registry_type>();
+
+        if(node) {
+            next->insert_or_assign(info, node);
+        } else {
+            next->erase(info);
+        }
+
+        std::atomic_store_explicit(&registry, std::shared_ptr<const registry_type>{std::move(next)}, std::memory_order_release);
+    }
+
+    // polymorphic types registered so far, replaced as a whole on updates
+    inline static std::shared_ptr<const registry_type> registry{};
+};
+
+
+struct slot_node {
+    using size_type = std::size_t;
+
+    static size_type intern(const size_type identifier) {
+        std::lock_guard<std::recursive_mutex> guard{type_info<>::mutex};
+        return index.try_emplace(identifier, index.size()).first->second;
+    }
+
+    // slots are never reused, guarded by the global mutex
+    inline static std::unordered_map<size_type, size_type> index{};
+};
+
+
+inline void * cast(const type_node *node, const type_node *type, void *instance) noexcept {
+    bool derived = true;
     void *ret = nullptr;
 
     if(node == type) {
         ret = instance;
-    } else {
-        const auto *base = find_if<&type_node::base>([type](auto *candidate) {
-            return candidate->ref() == type;
-        }, node);
+    } else if(!frozen_derived(node, type, derived) || derived) {
+        const auto *base = lookup_cache::find<&type_node::base>(node, reinterpret_cast<std::uintptr_t>(type), [node, type]() {
+            return find_if<&type_node::base>([type](auto *candidate) {
+                return candidate->ref() == type;
+            }, node);
+        });
 
         ret = base ? base->cast(instance) : nullptr;
     }
 
+    return ret;
+}
+
+
+// walks down from a base to the target type through the whole hierarchy of the latter
+inline void * downcast_closure(const type_node *node, const type_node *type, void *instance) noexcept {
+    void *ret = nullptr;
+
+    for(base_node *curr = type->base; curr && !ret; curr = curr->next) {
+        if(!curr->downcast) {
+            continue;
+        } else if(curr->ref() == node) {
+            ret = curr->downcast(instance);
+        } else if(auto *other = downcast_closure(node, curr->ref(), instance); other) {
+            ret = curr->downcast(other);
+        }
+    }
+
+    return ret;
+}
+
+
+inline void * downcast(const type_node *node, const type_node *type, void *instance) noexcept {
+    const type_node *actual = nullptr;
+    auto *complete = const_cast<void *>(node->dynamic(instance, actual));
+    void *ret = nullptr;
+
+    if(actual) {
+        // upcasts from the most derived type also cover cross casts
+        ret = (actual == node) ? nullptr : cast(actual, type, complete);
+    } else {
+        ret = downcast_closure(node, type, instance);
+    }
+
+    return ret;
+}
+
+
+template<typename Type>
+const Type * try_cast(const type_node *node, void *instance) noexcept {
+    const auto *type = type_info<Type>::resolve();
+    auto *ret = cast(node, type, instance);
+
+    if constexpr(std::is_class_v<Type>) {
+        if(!ret && node && node->dynamic && instance) {
+            ret = downcast(node, type, instance);
+        }
+    }
+
     return static_cast<const Type *>(ret);
 }
 
 
 template<auto Member>
 inline bool can_cast_or_convert(const type_node *from, const type_node *to) noexcept {
-    return (from == to) || find_if<Member>([to](auto *node) {
-        return node->ref() == to;
-    }, from);
+    if constexpr(std::is_same_v<decltype(Member), decltype(&type_node::base)>) {
+        return (from == to) || derived_from(from, to);
+    } else {
+        return (from == to) || find_if<Member>([to](auto *node) {
+            return node->ref() == to;
+        }, from);
+    }
 }
 
 
@@ -278,10 +1067,98 @@ inline auto ctor(std::index_sequence<Indexes...>, const type_node *node) noexcep
 }
 
 
-/**
- * Internal details not to be documented.
- * @endcond TURN_OFF_DOXYGEN
- */
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief Meta context object.
+ *
+ * A meta context is an isolated registry of meta types. Types registered with
+ * a context can only be searched by identifier through that context and don't
+ * appear among the types of the default context nor of any other context.<br/>
+ * Contexts are independent of each other. Different threads can search types
+ * from different contexts in parallel, while registrations are serialized by
+ * a global lock whatever context they target.
+ *
+ * Contexts only isolate lookups by identifier. There exists a single meta type
+ * for each type, so a type can be registered with at most one context at a
+ * time. Searching for it by type ignores contexts unless one is given.<br/>
+ * Destroying a context unregisters all the types still registered with it and
+ * therefore blocks until all the existing read guards have been destroyed.
+ *
+ * @warning
+ * Destroying a context from a thread that owns a read guard results in a
+ * deadlock, as it happens when unregistering types.
+ */
+class context: private internal::context_node {
+    /*! @brief A context node is allowed to unwrap a meta context. */
+    friend struct internal::context_node;
+
+public:
+    /*! @brief Default constructor. */
+    context() noexcept = default;
+
+    /*! @brief Default copy constructor, deleted on purpose. */
+    context(const context &) = delete;
+
+    /*! @brief Unregisters all the types still registered with the context. */
+    ~context() {
+        thaw();
+
+        while(type) {
+            type->unregister();
+        }
+    }
+
+    /**
+     * @brief Default copy assignment operator, deleted on purpose.
+     * @return This meta context.
+     */
+    context & operator=(const context &) = delete;
+};
+
+
+/**
+ * @brief Read-side critical section for the meta system.
+ *
+ * As long as a read guard is alive, nodes that are unregistered meanwhile
+ * aren't reset nor made available for reuse. Therefore, it's safe to walk the
+ * meta types and their parts from a thread while another one unregisters them.
+ * Unregistering a type blocks until all the read guards that existed at the
+ * time of the request have been destroyed.
+ *
+ * @warning
+ * Unregistering types from a thread that owns a read guard results in a
+ * deadlock.<br/>
+ * An assertion will abort the execution at runtime in debug mode in this case.
+ */
+class read_guard {
+public:
+    /*! @brief Default constructor, enters a read-side critical section. */
+    read_guard() noexcept
+        : epoch{internal::epoch::enter()}
+    {}
+
+    /*! @brief Default copy constructor, deleted on purpose. */
+    read_guard(const read_guard &) = delete;
+
+    /*! @brief Leaves the read-side critical section. */
+    ~read_guard() {
+        internal::epoch::leave(epoch);
+    }
+
+    /**
+     * @brief Default copy assignment operator, deleted on purpose.
+     * @return This read guard.
+     */
+    read_guard & operator=(const read_guard &) = delete;
+
+private:
+    const std::size_t epoch;
+};
 
 
 /**
@@ -300,6 +1177,9 @@ class any {
     /*! @brief A meta handle is allowed to _inherit_ from a meta any. */
     friend class handle;
 
+    /*! @brief Inline caches look at the type of the contained object. */
+    template<typename, std::size_t> friend class inline_cache;
+
     using storage_type = std::aligned_storage_t<sizeof(void *), alignof(void *)>;
     using copy_fn_type = void *(storage_type &, const void *);
     using destroy_fn_type = void(void *);
@@ -625,6 +1505,28 @@ public:
         return node == other.node && (!node || node->compare(instance, other.instance));
     }
 
+    /**
+     * @brief Returns the hash value of the contained object.
+     *
+     * Objects are hashed with `std::hash` when it's specialized for their
+     * types. Otherwise, the hash value is composed from those of the
+     * non-static data members and of the base classes, recursively.<br/>
+     * Objects of types that offer neither a specialization of `std::hash` nor
+     * meta data all have the same hash value.
+     *
+     * @warning
+     * The equality operator of a type without a specialization of `std::hash`
+     * must agree with its reflected members, that is, objects that compare
+     * equal must have equal reflected members and bases.
+     *
+     * Members are walked within a read guard. Getters invoked meanwhile must
+     * not unregister types.
+     *
+     * @return The hash value of the contained object, zero if the container is
+     * empty.
+     */
+    inline std::size_t hash() const;
+
     /**
      * @brief Swaps two meta any objects.
      * @param lhs A valid meta any object.
@@ -676,6 +1578,30 @@ class handle {
     /*! @brief A meta any is allowed to _inherit_ from a meta handle. */
     friend class any;
 
+    /*! @brief Inline caches look at the type of the underlying object. */
+    template<typename, std::size_t> friend class inline_cache;
+
+    /*! @brief Serializers work directly on the underlying object. */
+    friend class serializer;
+
+    /*! @brief Deserializers work directly on the underlying object. */
+    friend class deserializer;
+
+    /*! @brief Flat writers copy objects into the images. */
+    friend class flat_writer;
+
+    /*! @brief Flat views return handles into the images. */
+    friend class flat_view;
+
+    /*! @brief JSON writers encode the underlying object. */
+    friend class json_writer;
+
+    /*! @brief JSON readers decode into the underlying object. */
+    friend class json_reader;
+
+    /*! @brief Deltas are computed and applied on the underlying object. */
+    friend struct internal::delta_codec;
+
 public:
     /*! @brief Default constructor. */
     handle() noexcept
@@ -783,6 +1709,44 @@ public:
         return node->value();
     }
 
+    /**
+     * @brief Returns the stored key without copying it.
+     *
+     * The meta any object returned is an alias for the key stored with the
+     * property and doesn't own it. It's valid as long as the property is.
+     *
+     * @warning
+     * Modifying the key through the meta any object results in undefined
+     * behavior.
+     *
+     * @return A meta any that refers to the key stored with the property.
+     */
+    any key_ref() const noexcept {
+        return node->key_ref();
+    }
+
+    /**
+     * @brief Returns the stored value without copying it.
+     *
+     * The meta any object returned is an alias for the value stored with the
+     * property and doesn't own it. It's valid as long as the property is.<br/>
+     * Reading a property this way costs nothing, no matter how expensive the
+     * value is to copy:
+     *
+     * @code{.cpp}
+     * const auto *tooltip = prop.value_ref().try_cast<std::string>();
+     * @endcode
+     *
+     * @warning
+     * Modifying the value through the meta any object results in undefined
+     * behavior.
+     *
+     * @return A meta any that refers to the value stored with the property.
+     */
+    any value_ref() const noexcept {
+        return node->value_ref();
+    }
+
     /**
      * @brief Returns true if a meta object is valid, false otherwise.
      * @return True if the meta object is valid, false otherwise.
@@ -1056,9 +2020,7 @@ public:
     template<typename Key>
     std::enable_if_t<!std::is_invocable_v<Key, meta::prop>, meta::prop>
     prop(Key &&key) const noexcept {
-        const auto *curr = internal::find_if([key = any{std::forward<Key>(key)}](auto *candidate) {
-            return candidate->key() == key;
-        }, node->prop);
+        const auto *curr = internal::find_if(internal::match_key(key), node->prop);
 
         return curr ? curr->clazz() : meta::prop{};
     }
@@ -1191,6 +2153,14 @@ public:
         : node{nullptr}
     {}
 
+    /**
+     * @brief Returns the name of a given meta data, if any.
+     * @return The name of the meta data, an empty string if it has none.
+     */
+    std::string_view name() const noexcept {
+        return node->name;
+    }
+
     /**
      * @brief Returns the meta type to which a meta data belongs.
      * @return The meta type to which the meta data belongs.
@@ -1313,9 +2283,7 @@ public:
     template<typename Key>
     std::enable_if_t<!std::is_invocable_v<Key, meta::prop>, meta::prop>
     prop(Key &&key) const noexcept {
-        const auto *curr = internal::find_if([key = any{std::forward<Key>(key)}](auto *candidate) {
-            return candidate->key() == key;
-        }, node->prop);
+        const auto *curr = internal::find_if(internal::match_key(key), node->prop);
 
         return curr ? curr->clazz() : meta::prop{};
     }
@@ -1377,6 +2345,14 @@ public:
         : node{nullptr}
     {}
 
+    /**
+     * @brief Returns the name of a given meta function, if any.
+     * @return The name of the meta function, an empty string if it has none.
+     */
+    std::string_view name() const noexcept {
+        return node->name;
+    }
+
     /**
      * @brief Returns the meta type to which a meta function belongs.
      * @return The meta type to which the meta function belongs.
@@ -1474,9 +2450,7 @@ public:
     template<typename Key>
     std::enable_if_t<!std::is_invocable_v<Key, meta::prop>, meta::prop>
     prop(Key &&key) const noexcept {
-        const auto *curr = internal::find_if([key = any{std::forward<Key>(key)}](auto *candidate) {
-            return candidate->key() == key;
-        }, node->prop);
+        const auto *curr = internal::find_if(internal::match_key(key), node->prop);
 
         return curr ? curr->clazz() : meta::prop{};
     }
@@ -1515,6 +2489,58 @@ inline bool operator!=(const func &lhs, const func &rhs) noexcept {
 }
 
 
+/**
+ * @brief Interned identifier of a member function.
+ *
+ * Each identifier is given a small, dense index the first time it's interned.
+ * Indexes are assigned once and for all, therefore slots can be created when
+ * setting up a call site and reused for the lifetime of the program:
+ *
+ * @code{.cpp}
+ * static const meta::slot slot{hash("member")};
+ * meta::func func = type.func(slot);
+ * @endcode
+ *
+ * Once the registry is frozen, looking up a meta function by slot costs an
+ * indexed load, no matter whether it belongs to the given type or to one of
+ * its base classes.
+ */
+class slot {
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructs a slot and interns the given identifier if required.
+     * @param identifier Unique identifier of a member function.
+     */
+    explicit slot(const size_type identifier)
+        : pos{internal::slot_node::intern(identifier)},
+          id{identifier}
+    {}
+
+    /**
+     * @brief Returns the dense index of the interned identifier.
+     * @return The dense index of the interned identifier.
+     */
+    size_type index() const noexcept {
+        return pos;
+    }
+
+    /**
+     * @brief Returns the identifier the slot was created for.
+     * @return The identifier the slot was created for.
+     */
+    size_type identifier() const noexcept {
+        return id;
+    }
+
+private:
+    size_type pos;
+    size_type id;
+};
+
+
 /**
  * @brief Meta type object.
  *
@@ -1525,6 +2551,21 @@ class type {
     /*! @brief A meta node is allowed to create meta objects. */
     template<typename...> friend struct internal::info_node;
 
+    /*! @brief Inline caches use meta types as keys. */
+    template<typename, std::size_t> friend class inline_cache;
+
+    /*! @brief Serializers compile plans from meta types. */
+    friend class serializer;
+
+    /*! @brief Deserializers compile plans from meta types. */
+    friend class deserializer;
+
+    /*! @brief Flat views check meta types against images. */
+    friend class flat_view;
+
+    /*! @brief Deltas compile plans from meta types. */
+    friend struct internal::delta_codec;
+
     type(const internal::type_node *curr) noexcept
         : node{curr}
     {}
@@ -1538,12 +2579,45 @@ public:
         : node{nullptr}
     {}
 
+    /**
+     * @brief Returns the name of a given meta type, if any.
+     * @return The name of the meta type, an empty string if it has none.
+     */
+    std::string_view name() const noexcept {
+        return node->name;
+    }
+
+    /**
+     * @brief Returns the traits of a given meta type.
+     * @return The traits of the underlying type, packed in a bitmask.
+     */
+    meta::traits traits() const noexcept {
+        return node->traits;
+    }
+
+    /**
+     * @brief Indicates whether a given meta type has any of the given traits.
+     *
+     * Multiple traits can be tested at once by combining them, as an example:
+     *
+     * @code{.cpp}
+     * type.is(meta::traits::is_integral | meta::traits::is_floating_point);
+     * @endcode
+     *
+     * @param mask A mask of traits.
+     * @return True if the underlying type has at least one of the given traits,
+     * false otherwise.
+     */
+    bool is(const meta::traits mask) const noexcept {
+        return (node->traits & mask) != meta::traits::none;
+    }
+
     /**
      * @brief Indicates whether a given meta type refers to void or not.
      * @return True if the underlying type is void, false otherwise.
      */
     bool is_void() const noexcept {
-        return node->is_void;
+        return is(meta::traits::is_void);
     }
 
     /**
@@ -1552,7 +2626,7 @@ public:
      * @return True if the underlying type is an integral type, false otherwise.
      */
     bool is_integral() const noexcept {
-        return node->is_integral;
+        return is(meta::traits::is_integral);
     }
 
     /**
@@ -1562,7 +2636,7 @@ public:
      * otherwise.
      */
     bool is_floating_point() const noexcept {
-        return node->is_floating_point;
+        return is(meta::traits::is_floating_point);
     }
 
     /**
@@ -1571,7 +2645,7 @@ public:
      * @return True if the underlying type is an array type, false otherwise.
      */
     bool is_array() const noexcept {
-        return node->is_array;
+        return is(meta::traits::is_array);
     }
 
     /**
@@ -1579,7 +2653,7 @@ public:
      * @return True if the underlying type is an enum, false otherwise.
      */
     bool is_enum() const noexcept {
-        return node->is_enum;
+        return is(meta::traits::is_enum);
     }
 
     /**
@@ -1587,7 +2661,7 @@ public:
      * @return True if the underlying type is an union, false otherwise.
      */
     bool is_union() const noexcept {
-        return node->is_union;
+        return is(meta::traits::is_union);
     }
 
     /**
@@ -1595,7 +2669,7 @@ public:
      * @return True if the underlying type is a class, false otherwise.
      */
     bool is_class() const noexcept {
-        return node->is_class;
+        return is(meta::traits::is_class);
     }
 
     /**
@@ -1603,7 +2677,7 @@ public:
      * @return True if the underlying type is a pointer, false otherwise.
      */
     bool is_pointer() const noexcept {
-        return node->is_pointer;
+        return is(meta::traits::is_pointer);
     }
 
     /**
@@ -1613,7 +2687,7 @@ public:
      * otherwise.
      */
     bool is_function_pointer() const noexcept {
-        return node->is_function_pointer;
+        return is(meta::traits::is_function_pointer);
     }
 
     /**
@@ -1623,7 +2697,7 @@ public:
      * otherwise.
      */
     bool is_member_object_pointer() const noexcept {
-        return node->is_member_object_pointer;
+        return is(meta::traits::is_member_object_pointer);
     }
 
     /**
@@ -1633,7 +2707,7 @@ public:
      * false otherwise.
      */
     bool is_member_function_pointer() const noexcept {
-        return node->is_member_function_pointer;
+        return is(meta::traits::is_member_function_pointer);
     }
 
     /**
@@ -1646,6 +2720,23 @@ public:
         return node->extent;
     }
 
+    /**
+     * @brief Returns a fingerprint of the layout of the underlying type.
+     *
+     * The fingerprint depends on the identifiers and the types of the data
+     * members, on their offsets (when available), on the size of the type and
+     * on the fingerprints of the base classes. Static and constant data
+     * members don't contribute to it.<br/>
+     * Two types with the same fingerprint are serialized in the same way.
+     * Fingerprints are computed the first time they are requested and cached
+     * per thread until types are registered or unregistered.
+     *
+     * @return A fingerprint of the layout of the underlying type.
+     */
+    std::size_t schema_hash() const {
+        return internal::schema_hash(node);
+    }
+
     /**
      * @brief Provides the meta type for which the pointer is defined.
      * @return The meta type for which the pointer is defined or this meta type
@@ -1655,6 +2746,21 @@ public:
         return node->remove_pointer();
     }
 
+    /**
+     * @brief Checks whether a given meta type derives from another meta type.
+     *
+     * Searches recursively among **all** the base classes of the given type.
+     * Once the registry is frozen, this function doesn't walk the hierarchy
+     * and does the same amount of work regardless of its depth.
+     *
+     * @param other A valid meta type.
+     * @return True if the other meta type is a direct or indirect base of this
+     * meta type, false otherwise.
+     */
+    bool is_derived_from(const meta::type &other) const noexcept {
+        return other && internal::derived_from(node, other.node);
+    }
+
     /**
      * @brief Iterates all the meta base of a meta type.
      *
@@ -1781,13 +2887,28 @@ public:
      * @return The meta data associated with the given identifier, if any.
      */
     meta::data data(const std::size_t identifier) const noexcept {
-        const auto *curr = internal::find_if<&internal::type_node::data>([identifier](auto *candidate) {
-            return candidate->identifier == identifier;
-        }, node);
+        const auto *curr = internal::lookup_cache::find<&internal::type_node::data>(node, identifier, [node = node, identifier]() {
+            return internal::find<&internal::type_node::data>(identifier, node);
+        });
 
         return curr ? curr->clazz() : meta::data{};
     }
 
+    /**
+     * @brief Returns the meta data associated with a given name.
+     *
+     * Names are looked up by means of their hash, exactly as it happens with
+     * identifiers. The name of the candidate is compared afterwards to verify
+     * the match.
+     *
+     * @param name The name of the meta data to search for.
+     * @return The meta data associated with the given name, if any.
+     */
+    meta::data data(const std::string_view name) const noexcept {
+        const auto curr = data(hashed_string::value(name.data(), name.size()));
+        return (curr && curr.name() == name) ? curr : meta::data{};
+    }
+
     /**
      * @brief Iterates all the meta functions of a meta type.
      *
@@ -1817,13 +2938,49 @@ public:
      * @return The meta function associated with the given identifier, if any.
      */
     meta::func func(const std::size_t identifier) const noexcept {
-        const auto *curr = internal::find_if<&internal::type_node::func>([identifier](auto *candidate) {
-            return candidate->identifier == identifier;
-        }, node);
+        const auto *curr = internal::lookup_cache::find<&internal::type_node::func>(node, identifier, [node = node, identifier]() {
+            return internal::find<&internal::type_node::func>(identifier, node);
+        });
 
         return curr ? curr->clazz() : meta::func{};
     }
 
+    /**
+     * @brief Returns the meta function associated with a given slot.
+     *
+     * Searches recursively among **all** the meta functions of the given type.
+     * Once the registry is frozen, a flat dispatch table is used and the meta
+     * functions of the base classes aren't inspected one at a time.
+     *
+     * @param slot A slot created for the identifier of the meta function.
+     * @return The meta function associated with the given slot, if any.
+     */
+    meta::func func(const meta::slot &slot) const noexcept {
+        if(const auto *record = node ? node->frozen.load(std::memory_order_acquire) : nullptr; record && record->arena->closed[record->index]) {
+            const auto &arena = *record->arena;
+            const auto pos = arena.dispatch_offset[record->index] + slot.index();
+            const bool match = pos < arena.dispatch_size && arena.dispatch[pos].row == record->index;
+            return match ? arena.dispatch[pos].func->clazz() : meta::func{};
+        }
+
+        return func(slot.identifier());
+    }
+
+    /**
+     * @brief Returns the meta function associated with a given name.
+     *
+     * Names are looked up by means of their hash, exactly as it happens with
+     * identifiers. The name of the candidate is compared afterwards to verify
+     * the match.
+     *
+     * @param name The name of the meta function to search for.
+     * @return The meta function associated with the given name, if any.
+     */
+    meta::func func(const std::string_view name) const noexcept {
+        const auto curr = func(hashed_string::value(name.data(), name.size()));
+        return (curr && curr.name() == name) ? curr : meta::func{};
+    }
+
     /**
      * @brief Creates an instance of the underlying type, if possible.
      *
@@ -1898,9 +3055,7 @@ public:
     template<typename Key>
     std::enable_if_t<!std::is_invocable_v<Key, meta::prop>, meta::prop>
     prop(Key &&key) const noexcept {
-        const auto *curr = internal::find_if<&internal::type_node::prop>([key = any{std::forward<Key>(key)}](auto *candidate) {
-            return candidate->key() == key;
-        }, node);
+        const auto *curr = internal::find_if<&internal::type_node::prop>(internal::match_key(key), node);
 
         return curr ? curr->clazz() : meta::prop{};
     }
@@ -1939,6 +3094,126 @@ inline bool operator!=(const type &lhs, const type &rhs) noexcept {
 }
 
 
+/**
+ * @brief Inline cache for the meta data or meta functions of a call site.
+ *
+ * An inline cache remembers the meta objects found for the given identifier
+ * in the last few types it was used with. As long as a call site sees the same
+ * types, only the pointers to the meta types are compared and the meta objects
+ * aren't searched again:
+ *
+ * @code{.cpp}
+ * meta::inline_cache<meta::data> cache{hash("member")};
+ * meta::data data = cache(handle);
+ * @endcode
+ *
+ * Any change to the registry (as an example, when a type is unregistered)
+ * empties the cache at the next lookup.
+ *
+ * @warning
+ * Inline caches aren't thread safe. Call sites that are hit from multiple
+ * threads should use an inline cache per thread.
+ *
+ * @tparam Member Either meta data or meta functions.
+ * @tparam Size Number of types to remember, more than one for polymorphic call
+ * sites.
+ */
+template<typename Member, std::size_t Size = 1u>
+class inline_cache {
+    static_assert(std::is_same_v<Member, data> || std::is_same_v<Member, func>);
+    static_assert(Size);
+
+    using node_type = std::conditional_t<std::is_same_v<Member, data>, internal::data_node, internal::func_node>;
+
+    struct entry {
+        const internal::type_node *type;
+        const node_type *node;
+    };
+
+    Member lookup(const internal::type_node *type) noexcept {
+        if(const auto curr = internal::lookup_cache::generation(); curr != generation) {
+            entries = {};
+            generation = curr;
+        }
+
+        auto *elem = std::find_if(entries.begin(), entries.end(), [type](const auto &candidate) {
+            return candidate.type == type;
+        });
+
+        if(elem == entries.end()) {
+            // round-robin replacement, the oldest type is forgotten first
+            elem = entries.data() + std::exchange(next, (next + 1u) % Size);
+            const node_type *node = nullptr;
+
+            if constexpr(std::is_same_v<Member, data>) {
+                node = internal::find<&internal::type_node::data>(identifier, type);
+            } else {
+                node = internal::find<&internal::type_node::func>(identifier, type);
+            }
+
+            *elem = { type, node };
+        }
+
+        return elem->node ? elem->node->clazz() : Member{};
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructs an inline cache for a given identifier.
+     * @param id Unique identifier of the meta data or meta function.
+     */
+    explicit inline_cache(const size_type id) noexcept
+        : identifier{id}
+    {}
+
+    /**
+     * @brief Returns the meta object associated with the given meta type.
+     * @param type A meta type, either valid or not.
+     * @return The meta object associated with the identifier, if any.
+     */
+    Member operator()(const meta::type &type) noexcept {
+        return lookup(type.node);
+    }
+
+    /**
+     * @brief Returns the meta object associated with the type of an object.
+     * @param handle A meta handle, either empty or not.
+     * @return The meta object associated with the identifier, if any.
+     */
+    Member operator()(const handle &handle) noexcept {
+        return lookup(handle.node);
+    }
+
+    /**
+     * @brief Returns the meta object associated with the type of an object.
+     * @param any A meta any object, either empty or not.
+     * @return The meta object associated with the identifier, if any.
+     */
+    Member operator()(const any &any) noexcept {
+        return lookup(any.node);
+    }
+
+private:
+    const size_type identifier;
+    std::array<entry, Size> entries{};
+    size_type generation{};
+    size_type next{};
+};
+
+
+inline internal::context_node & internal::context_node::from(context &ctx) noexcept {
+    return ctx;
+}
+
+
+inline const internal::context_node & internal::context_node::from(const context &ctx) noexcept {
+    return ctx;
+}
+
+
 inline any::any(handle handle) noexcept
     : any{}
 {
@@ -1957,6 +3232,51 @@ inline meta::type handle::type() const noexcept {
 }
 
 
+inline std::size_t any::hash() const {
+    if(!node) {
+        return 0u;
+    } else if(node->hash) {
+        return node->hash(instance);
+    }
+
+    using traits_type = internal::fnv1a_traits<sizeof(std::size_t)>;
+    auto partial{traits_type::offset};
+
+    const read_guard guard{};
+
+    const auto combine = [&partial](const std::size_t value) {
+        partial = (partial ^ value) * traits_type::prime;
+    };
+
+    handle self{};
+    self.node = node;
+    self.instance = instance;
+
+    for(internal::data_node *curr = node->data; curr; curr = curr->next) {
+        if(!curr->is_static) {
+            if(curr->address) {
+                // members at a fixed offset are hashed in place, no copies are made
+                handle elem{};
+                elem.node = curr->ref();
+                elem.instance = curr->address(instance);
+                combine(any{elem}.hash());
+            } else {
+                combine(curr->get(self, {}).hash());
+            }
+        }
+    }
+
+    for(internal::base_node *curr = node->base; curr; curr = curr->next) {
+        handle elem{};
+        elem.node = curr->ref();
+        elem.instance = curr->cast(instance);
+        combine(any{elem}.hash());
+    }
+
+    return static_cast<std::size_t>(partial);
+}
+
+
 inline meta::type base::parent() const noexcept {
     return node->parent->clazz();
 }
@@ -2039,38 +3359,112 @@ static bool compare(char, const void *lhs, const void *rhs) {
 
 
 template<typename Type>
-inline type_node * info_node<Type>::resolve() noexcept {
-    if(!type) {
-        static type_node node{
-            {},
-            nullptr,
-            nullptr,
-            std::is_void_v<Type>,
-            std::is_integral_v<Type>,
-            std::is_floating_point_v<Type>,
-            std::is_array_v<Type>,
-            std::is_enum_v<Type>,
-            std::is_union_v<Type>,
-            std::is_class_v<Type>,
-            std::is_pointer_v<Type>,
-            std::is_pointer_v<Type> && std::is_function_v<std::remove_pointer_t<Type>>,
-            std::is_member_object_pointer_v<Type>,
-            std::is_member_function_pointer_v<Type>,
-            std::extent_v<Type>,
-            [](const void *lhs, const void *rhs) {
-                return compare<Type>(0, lhs, rhs);
-            },
-            []() noexcept -> meta::type {
-                return internal::type_info<std::remove_pointer_t<Type>>::resolve();
-            },
-            []() noexcept -> meta::type {
-                return &node;
-            }
+constexpr auto hash_of() noexcept
+-> std::size_t(*)(const void *) {
+    if constexpr(std::is_default_constructible_v<std::hash<Type>>) {
+        return [](const void *instance) -> std::size_t {
+            return std::hash<Type>{}(*static_cast<const Type *>(instance));
+        };
+    } else {
+        return nullptr;
+    }
+}
+
+
+template<typename Type>
+constexpr meta::traits traits_of() noexcept {
+    const std::pair<bool, meta::traits> candidate[]{
+        { std::is_void_v<Type>, meta::traits::is_void },
+        { std::is_integral_v<Type>, meta::traits::is_integral },
+        { std::is_floating_point_v<Type>, meta::traits::is_floating_point },
+        { std::is_array_v<Type>, meta::traits::is_array },
+        { std::is_enum_v<Type>, meta::traits::is_enum },
+        { std::is_union_v<Type>, meta::traits::is_union },
+        { std::is_class_v<Type>, meta::traits::is_class },
+        { std::is_pointer_v<Type>, meta::traits::is_pointer },
+        { std::is_pointer_v<Type> && std::is_function_v<std::remove_pointer_t<Type>>, meta::traits::is_function_pointer },
+        { std::is_member_object_pointer_v<Type>, meta::traits::is_member_object_pointer },
+        { std::is_member_function_pointer_v<Type>, meta::traits::is_member_function_pointer },
+        { std::is_trivially_copyable_v<Type>, meta::traits::is_trivially_copyable }
+    };
+
+    auto mask = meta::traits::none;
+
+    for(auto &&curr: candidate) {
+        mask = curr.first ? (mask | curr.second) : mask;
+    }
+
+    return mask;
+}
+
+
+template<typename Type>
+constexpr std::size_t size_of() noexcept {
+    if constexpr(std::is_object_v<Type> && !(std::is_array_v<Type> && !std::extent_v<Type>)) {
+        return sizeof(Type);
+    } else {
+        return 0u;
+    }
+}
+
+
+template<typename Type>
+constexpr bool unique_of() noexcept {
+    if constexpr(std::is_object_v<Type> && !(std::is_array_v<Type> && !std::extent_v<Type>)) {
+        // equal values have equal bytes, there are no paddings
+        return std::has_unique_object_representations_v<Type>;
+    } else {
+        return false;
+    }
+}
+
+
+template<typename Type>
+constexpr auto dynamic_of() noexcept
+-> const void *(*)(const void *, const type_node *&) noexcept {
+    if constexpr(std::is_polymorphic_v<Type>) {
+        return [](const void *instance, const type_node *&node) noexcept -> const void * {
+            const auto *ptr = static_cast<const Type *>(instance);
+            node = dynamic_cache::find(typeid(*ptr));
+            return dynamic_cast<const void *>(ptr);
         };
+    } else {
+        return nullptr;
+    }
+}
+
+
+template<typename Type>
+type_node info_node<Type>::node{
+    {},
+    nullptr,
+    nullptr,
+    traits_of<Type>(),
+    std::extent_v<Type>,
+    size_of<Type>(),
+    unique_of<Type>(),
+    [](const void *lhs, const void *rhs) {
+        return compare<Type>(0, lhs, rhs);
+    },
+    hash_of<Type>(),
+    []() noexcept -> meta::type {
+        return internal::type_info<std::remove_pointer_t<Type>>::resolve();
+    },
+    []() noexcept -> meta::type {
+        return &node;
+    },
+    dynamic_of<Type>()
+};
 
+
+template<typename Type>
+inline type_node * info_node<Type>::resolve() noexcept {
+    if(!type) {
         type = &node;
     }
 
+    realize(type);
+
     return type;
 }
 
@@ -2087,4 +3481,24 @@ inline type_node * info_node<Type>::resolve() noexcept {
 }
 
 
+namespace std {
+
+
+/*! @brief Hash support for meta any objects. */
+template<>
+struct hash<meta::any> {
+    /**
+     * @brief Returns the hash value of a meta any object.
+     * @param any A meta any object, either empty or not.
+     * @return The hash value of the contained object.
+     */
+    std::size_t operator()(const meta::any &any) const {
+        return any.hash();
+    }
+};
+
+
+}
+
+
 #endif // META_META_HPP
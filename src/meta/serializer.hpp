@@ -0,0 +1,656 @@
+#ifndef META_SERIALIZER_HPP
+#define META_SERIALIZER_HPP
+
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include "meta.hpp"
+
+
+namespace meta {
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+struct layout_plan {
+    using size_type = std::size_t;
+
+    struct step {
+        // runs have no data node, members with an address are at a fixed offset from their segment
+        size_type offset;
+        size_type size;
+        const data_node *data;
+        const type_node *type;
+    };
+
+    struct segment {
+        const type_node *parent;
+        std::vector<const base_node *> path;
+        size_type first;
+        size_type last;
+    };
+
+    struct field {
+        step target;
+        size_type segment;
+        std::size_t hash;
+        size_type size;
+    };
+
+    struct column {
+        // paddings have no identifier nor hash, readers skip them as unknown members
+        std::size_t identifier;
+        std::size_t hash;
+        size_type size;
+    };
+
+    std::vector<segment> segments{};
+    std::vector<step> steps{};
+    std::vector<field> fields{};
+    std::vector<column> columns{};
+    std::size_t schema{};
+    size_type size{};
+    bool valid{};
+    bool raw{};
+};
+
+
+inline bool trivial(const type_node *node) noexcept;
+
+
+inline bool trivial(const type_node *node, bool &known) noexcept {
+    for(internal::data_node *curr = node->data; curr; curr = curr->next) {
+        if(!curr->is_static) {
+            // constant members cannot be overwritten with a copy
+            if(curr->is_const || !trivial(curr->ref())) {
+                return false;
+            }
+
+            known = true;
+        }
+    }
+
+    for(internal::base_node *curr = node->base; curr; curr = curr->next) {
+        if(!trivial(curr->ref(), known)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+inline bool trivial(const type_node *node) noexcept {
+    constexpr auto pointers = meta::traits::is_pointer | meta::traits::is_member_object_pointer | meta::traits::is_member_function_pointer;
+
+    if((node->traits & meta::traits::is_trivially_copyable) == meta::traits::none || (node->traits & pointers) != meta::traits::none || !node->size) {
+        return false;
+    } else if((node->traits & (meta::traits::is_class | meta::traits::is_union)) == meta::traits::none) {
+        return true;
+    }
+
+    // addresses copied as they are would dangle, classes are copied as a whole only if their members are known
+    bool known{};
+    return trivial(node, known) && known;
+}
+
+
+inline layout_plan layout(const type_node *node);
+
+
+inline bool layout(const type_node *node, std::vector<const base_node *> &path, std::vector<const type_node *> &visited, layout_plan &plan) {
+    if(std::find(visited.cbegin(), visited.cend(), node) != visited.cend()) {
+        return true;
+    }
+
+    visited.push_back(node);
+
+    const auto first = plan.steps.size();
+    const auto segment = plan.segments.size();
+    bool valid = true;
+
+    for(auto &&curr: schema_fields(node)) {
+        const auto *type = curr.data->ref();
+        const layout_plan::step target{ curr.offset, trivial(type) ? type->size : 0u, curr.data, type };
+        auto size = target.size;
+
+        if(!size) {
+            const auto nested = layout(type);
+            valid = valid && nested.valid;
+            size = nested.size;
+        }
+
+        plan.fields.push_back({ target, segment, schema_hash(type), size });
+        plan.size += size;
+
+        if(auto *prev = plan.steps.size() == first ? nullptr : &plan.steps.back(); prev && !prev->data && target.size && curr.data->address && prev->offset + prev->size == target.offset) {
+            // adjacent trivially copyable members are merged in a single run
+            prev->size += target.size;
+        } else {
+            plan.steps.push_back({ target.offset, target.size, (target.size && curr.data->address) ? nullptr : curr.data, type });
+        }
+    }
+
+    if(first != plan.steps.size()) {
+        plan.segments.push_back({ node, path, first, plan.steps.size() });
+    }
+
+    for(internal::base_node *curr = node->base; curr; curr = curr->next) {
+        path.push_back(curr);
+        valid = layout(curr->ref(), path, visited, plan) && valid;
+        path.pop_back();
+    }
+
+    return valid;
+}
+
+
+inline bool describe(const type_node *node, layout_plan &plan) {
+    using size_type = layout_plan::size_type;
+    std::vector<std::pair<size_type, const layout_plan::field *>> order{};
+
+    for(auto &&curr: plan.fields) {
+        if(!curr.target.data->address) {
+            return false;
+        }
+
+        auto offset = curr.target.offset;
+
+        for(auto *base: plan.segments[curr.segment].path) {
+            if(!base->fixed) {
+                return false;
+            }
+
+            offset += base->offset;
+        }
+
+        order.emplace_back(offset, &curr);
+    }
+
+    std::sort(order.begin(), order.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    size_type position{};
+
+    for(auto [offset, curr]: order) {
+        if(offset < position) {
+            // overlapping members, as it happens with unions
+            return false;
+        } else if(offset != position) {
+            plan.columns.push_back({ {}, {}, offset - position });
+        }
+
+        plan.columns.push_back({ curr->target.data->identifier, curr->hash, curr->size });
+        position = offset + curr->size;
+    }
+
+    if(position > node->size) {
+        return false;
+    } else if(position != node->size) {
+        plan.columns.push_back({ {}, {}, node->size - position });
+    }
+
+    return true;
+}
+
+
+inline layout_plan layout(const type_node *node) {
+    std::vector<const base_node *> path;
+    std::vector<const type_node *> visited;
+    layout_plan plan{};
+
+    plan.valid = layout(node, path, visited, plan) && !plan.fields.empty();
+    plan.schema = schema_hash(node);
+
+    if(plan.fields.empty()) {
+        plan.size = trivial(node) ? node->size : 0u;
+    } else if(plan.valid && trivial(node) && describe(node, plan)) {
+        // objects are copied as a whole, paddings included, and described by their layout in memory
+        plan.size = node->size;
+        plan.raw = true;
+    } else {
+        plan.columns.clear();
+
+        for(auto &&curr: plan.fields) {
+            plan.columns.push_back({ curr.target.data->identifier, curr.hash, curr.size });
+        }
+    }
+
+    return plan;
+}
+
+
+class layout_cache {
+    void sync() {
+        if(const auto curr = lookup_cache::generation(); curr != generation) {
+            plans.clear();
+            ctors.clear();
+            generation = curr;
+        }
+    }
+
+public:
+    const layout_plan & plan(const type_node *node) {
+        sync();
+
+        if(auto it = plans.find(node); it != plans.end()) {
+            return it->second;
+        }
+
+        return plans.emplace(node, layout(node)).first->second;
+    }
+
+    const ctor_node * ctor(const type_node *node) {
+        sync();
+
+        if(auto it = ctors.find(node); it != ctors.end()) {
+            return it->second;
+        }
+
+        return ctors.emplace(node, find_if([](const auto *curr) { return !curr->size; }, node->ctor)).first->second;
+    }
+
+private:
+    std::unordered_map<const type_node *, layout_plan> plans{};
+    std::unordered_map<const type_node *, const ctor_node *> ctors{};
+    std::size_t generation{};
+};
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief Reflection-driven binary serializer.
+ *
+ * A serializer compiles a reflected type into a flat plan the first time an
+ * instance of that type is written and reuses the plan afterwards.<br/>
+ * Trivially copyable types whose reflected members all sit at fixed offsets
+ * are written as a whole, paddings included, with a single call to `memcpy`.
+ * Otherwise, trivially copyable members registered as pointers to data
+ * members are copied as a whole and adjacent members are merged in a single
+ * run. Other reflected types are written recursively, while setter/getter
+ * pairs are the only members that go through their getters.
+ *
+ * Static and constant data members aren't part of the layout. Types that
+ * aren't reflected are written as a whole if trivially copyable, otherwise
+ * they cannot be serialized. Pointers, pointers to members and classes that
+ * aren't reflected cannot be serialized either, since they could carry
+ * addresses that would dangle once read back.
+ *
+ * Every object is preceded by the schema hash of its type. The first time a
+ * type appears in the buffer, the schema hash is followed by a description of
+ * its members, so that a deserializer can still decode objects of types that
+ * changed in the meantime.
+ *
+ * @warning
+ * The format doesn't account for endianness.<br/>
+ * A serializer isn't thread safe and registering or unregistering types
+ * invalidates all the compiled plans.
+ */
+class serializer {
+    void append(const void *instance, const std::size_t size) {
+        const auto *first = static_cast<const std::byte *>(instance);
+        buffer.insert(buffer.end(), first, first + size);
+    }
+
+    void append(const std::size_t value) {
+        append(&value, sizeof(value));
+    }
+
+    bool write(const internal::layout_plan &plan, void *instance) {
+        for(auto &&segment: plan.segments) {
+            auto *ptr = static_cast<std::byte *>(instance);
+
+            for(auto *base: segment.path) {
+                ptr = static_cast<std::byte *>(base->cast(ptr));
+            }
+
+            for(auto pos = segment.first; pos < segment.last; ++pos) {
+                const auto &step = plan.steps[pos];
+                void *elem = ptr + step.offset;
+                any value{};
+
+                if(step.data && !step.data->address) {
+                    handle parent{};
+                    parent.node = segment.parent;
+                    parent.instance = ptr;
+                    value = step.data->get(parent, {});
+                    elem = handle{value}.instance;
+                }
+
+                if(!elem) {
+                    return false;
+                } else if(step.size) {
+                    append(elem, step.size);
+                } else if(!write(cache.plan(step.type), elem)) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool write(const internal::type_node *node, void *instance) {
+        const auto &plan = cache.plan(node);
+        append(plan.schema);
+
+        if(std::find(schemas.cbegin(), schemas.cend(), plan.schema) == schemas.cend()) {
+            schemas.push_back(plan.schema);
+            append(plan.columns.size());
+
+            for(auto &&curr: plan.columns) {
+                append(curr.identifier);
+                append(curr.hash);
+                append(curr.size);
+            }
+        }
+
+        if(plan.valid && !plan.raw) {
+            return write(plan, instance);
+        } else if(plan.raw || (plan.fields.empty() && plan.size)) {
+            append(instance, plan.size);
+            return true;
+        }
+
+        return false;
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Appends an object to the buffer.
+     *
+     * The buffer is left untouched if the object cannot be serialized.
+     *
+     * @param handle A handle to the object to write.
+     * @return True in case of success, false otherwise.
+     */
+    bool write(handle handle) {
+        const auto size = buffer.size();
+        const auto known = schemas.size();
+
+        if(!handle || !write(handle.node, handle.instance)) {
+            buffer.resize(size);
+            schemas.resize(known);
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Returns a pointer to the serialized data.
+     * @return A pointer to the serialized data.
+     */
+    const std::byte * data() const noexcept {
+        return buffer.data();
+    }
+
+    /**
+     * @brief Returns the number of bytes written so far.
+     * @return The number of bytes written so far.
+     */
+    size_type size() const noexcept {
+        return buffer.size();
+    }
+
+    /*! @brief Clears the buffer, compiled plans are kept. */
+    void clear() noexcept {
+        buffer.clear();
+        schemas.clear();
+    }
+
+private:
+    std::vector<std::byte> buffer{};
+    std::vector<std::size_t> schemas{};
+    internal::layout_cache cache{};
+};
+
+
+/**
+ * @brief Reflection-driven binary deserializer.
+ *
+ * A deserializer reads back what a serializer wrote, using the same plans.
+ * Objects are decoded in place: runs are copied straight into their members
+ * and nested reflected types are decoded recursively, no meta any objects
+ * nor setters are involved for members registered as pointers to data
+ * members.<br/>
+ * Setter/getter pairs are the only exception. The value returned by the
+ * getter is decoded and then assigned through the setter.
+ *
+ * When the schema hash of an object matches that of its type, the object is
+ * decoded through the plan, that is with a single bulk copy for types that a
+ * serializer writes as a whole. Otherwise, members are matched by identifier
+ * and schema hash and decoded one at a time, while those that no longer exist
+ * and paddings are skipped.
+ *
+ * New instances are created with the default constructor of a type, if one
+ * has been registered. Default constructors are looked up once per type.
+ *
+ * @warning
+ * A deserializer doesn't own the data it reads from. Therefore, the latter
+ * must outlive the former.<br/>
+ * A deserializer isn't thread safe and registering or unregistering types
+ * invalidates all the compiled plans.
+ */
+class deserializer {
+    struct entry {
+        std::size_t identifier;
+        std::size_t hash;
+        std::size_t size;
+    };
+
+    bool consume(void *instance, const std::size_t size) noexcept {
+        if(static_cast<std::size_t>(last - curr) < size) {
+            return false;
+        }
+
+        std::memcpy(instance, curr, size);
+        curr += size;
+
+        return true;
+    }
+
+    bool read(const internal::layout_plan::segment &segment, const internal::layout_plan::step &step, void *instance) {
+        auto *ptr = static_cast<std::byte *>(instance);
+        void *elem = ptr + step.offset;
+        handle parent{};
+        any value{};
+
+        if(step.data && !step.data->address) {
+            parent.node = segment.parent;
+            parent.instance = ptr;
+            value = step.data->get(parent, {});
+            elem = handle{value}.instance;
+        }
+
+        if(!elem || !(step.size ? consume(elem, step.size) : read(cache.plan(step.type), elem))) {
+            return false;
+        }
+
+        return value ? step.data->set(parent, {}, std::move(value)) : true;
+    }
+
+    bool read(const internal::layout_plan &plan, void *instance) {
+        for(auto &&segment: plan.segments) {
+            auto *ptr = static_cast<std::byte *>(instance);
+
+            for(auto *base: segment.path) {
+                ptr = static_cast<std::byte *>(base->cast(ptr));
+            }
+
+            for(auto pos = segment.first; pos < segment.last; ++pos) {
+                if(!read(segment, plan.steps[pos], ptr)) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool read(const internal::layout_plan &plan, const std::vector<entry> &table, void *instance) {
+        for(auto &&column: table) {
+            const auto field = std::find_if(plan.fields.cbegin(), plan.fields.cend(), [&column](const auto &candidate) {
+                return candidate.target.data->identifier == column.identifier && candidate.hash == column.hash;
+            });
+
+            if(field == plan.fields.cend()) {
+                // members that no longer exist or whose type changed are skipped
+                if(static_cast<std::size_t>(last - curr) < column.size) {
+                    return false;
+                }
+
+                curr += column.size;
+            } else {
+                const auto &segment = plan.segments[field->segment];
+                void *ptr = instance;
+
+                for(auto *base: segment.path) {
+                    ptr = base->cast(ptr);
+                }
+
+                if(!read(segment, field->target, ptr)) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool read(const internal::type_node *node, void *instance) {
+        std::size_t schema{};
+
+        if(!consume(&schema, sizeof(schema))) {
+            return false;
+        }
+
+        auto it = schemas.find(schema);
+
+        if(it == schemas.end()) {
+            std::size_t count{};
+            std::vector<entry> table{};
+
+            if(!consume(&count, sizeof(count)) || static_cast<std::size_t>(last - curr) / sizeof(entry) < count) {
+                return false;
+            }
+
+            table.resize(count);
+
+            for(auto &&column: table) {
+                consume(&column.identifier, sizeof(column.identifier));
+                consume(&column.hash, sizeof(column.hash));
+                consume(&column.size, sizeof(column.size));
+            }
+
+            it = schemas.emplace(schema, std::move(table)).first;
+        }
+
+        if(const auto &plan = cache.plan(node); schema == plan.schema) {
+            return (plan.valid && !plan.raw) ? read(plan, instance) : ((plan.raw || (plan.fields.empty() && plan.size)) && consume(instance, plan.size));
+        } else {
+            // objects of types without members can only be copied as they are
+            return plan.valid && !it->second.empty() && read(plan, it->second, instance);
+        }
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructs a deserializer for a given buffer.
+     * @param data A pointer to the serialized data.
+     * @param size The number of bytes available.
+     */
+    deserializer(const std::byte *data, const size_type size) noexcept
+        : curr{data},
+          last{data + size}
+    {}
+
+    /**
+     * @brief Decodes the next object into an existing instance.
+     *
+     * The position in the buffer is left untouched if the object cannot be
+     * decoded. The instance may have been partially modified in this case.
+     *
+     * @param handle A handle to the object to decode into.
+     * @return True in case of success, false otherwise.
+     */
+    bool read(handle handle) {
+        const auto *first = curr;
+        const auto known = schemas.size();
+
+        if(!handle || !read(handle.node, handle.instance)) {
+            if(schemas.size() != known) {
+                std::size_t schema{};
+                std::memcpy(&schema, first, sizeof(schema));
+                schemas.erase(schema);
+            }
+
+            curr = first;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Decodes the next object into a new instance of a given type.
+     * @param type A valid meta type.
+     * @return A meta any containing the new instance, if any.
+     */
+    any read(const meta::type &type) {
+        any instance{};
+
+        if(const auto *ctor = cache.ctor(type.node); ctor) {
+            instance = ctor->invoke(nullptr);
+
+            if(!read(handle{instance})) {
+                instance = any{};
+            }
+        }
+
+        return instance;
+    }
+
+    /**
+     * @brief Returns the number of bytes not yet decoded.
+     * @return The number of bytes not yet decoded.
+     */
+    size_type size() const noexcept {
+        return static_cast<size_type>(last - curr);
+    }
+
+private:
+    const std::byte *curr;
+    const std::byte *last;
+    std::unordered_map<std::size_t, std::vector<entry>> schemas{};
+    internal::layout_cache cache{};
+};
+
+
+}
+
+
+#endif // META_SERIALIZER_HPP
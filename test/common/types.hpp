@@ -0,0 +1,46 @@
+#ifndef META_TEST_COMMON_TYPES_HPP
+#define META_TEST_COMMON_TYPES_HPP
+
+#include <meta/factory.hpp>
+#include <meta/hashed_string.hpp>
+#include <meta/meta.hpp>
+
+struct common_pod_type {
+    int i;
+    char c;
+    double d;
+    static inline int s{};
+};
+
+
+struct common_base_type {
+    virtual ~common_base_type() = default;
+    int base;
+};
+
+
+struct common_accessor_type {
+    void set(int v) { value = v * 2; }
+    int get() const { return value / 2; }
+
+    int value;
+};
+
+
+inline void reflect_common_types() {
+    // suites share the same executable, types are registered only once
+    [[maybe_unused]] static const bool reflected = [] {
+        meta::reflect<common_pod_type>("common_pod"_hs)
+                .data<&common_pod_type::i>("i"_hs)
+                .data<&common_pod_type::c>("c"_hs)
+                .data<&common_pod_type::d>("d"_hs)
+                .data<&common_pod_type::s>("s"_hs);
+
+        meta::reflect<common_base_type>("common_base"_hs)
+                .data<&common_base_type::base>("base"_hs);
+
+        return true;
+    }();
+}
+
+#endif // META_TEST_COMMON_TYPES_HPP
@@ -0,0 +1,176 @@
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+#include <meta/delta.hpp>
+#include <meta/factory.hpp>
+#include <meta/hashed_string.hpp>
+#include <meta/meta.hpp>
+#include <meta/serializer.hpp>
+#include "common/types.hpp"
+
+struct delta_inner_type {
+    delta_inner_type() = default;
+    delta_inner_type(const delta_inner_type &other): x{other.x}, y{other.y} {}
+    delta_inner_type & operator=(const delta_inner_type &) = default;
+
+    bool operator==(const delta_inner_type &other) const {
+        return x == other.x && y == other.y;
+    }
+
+    int x;
+    int y;
+};
+
+
+struct delta_record_type: common_base_type, common_accessor_type {
+    common_pod_type pod;
+    delta_inner_type inner;
+};
+
+
+struct Delta: ::testing::Test {
+    static void SetUpTestCase() {
+        reflect_common_types();
+
+        meta::reflect<delta_inner_type>("delta_inner"_hs)
+                .data<&delta_inner_type::x>("x"_hs)
+                .data<&delta_inner_type::y>("y"_hs);
+
+        meta::reflect<delta_record_type>("delta_record"_hs)
+                .base<common_base_type>()
+                .data<&delta_record_type::pod>("pod"_hs)
+                .data<&delta_record_type::inner>("inner"_hs)
+                .data<&delta_record_type::set, &delta_record_type::get>("value"_hs);
+    }
+
+    static delta_record_type record() {
+        delta_record_type instance{};
+        instance.base = 1;
+        instance.pod = {2, 'a', .5};
+        instance.inner.x = 3;
+        instance.inner.y = 4;
+        instance.set(5);
+        return instance;
+    }
+};
+
+
+TEST_F(Delta, Unchanged) {
+    const auto type = meta::resolve<delta_record_type>();
+    auto from = record();
+    auto to = record();
+
+    const auto delta = meta::diff(type, from, to);
+
+    // schema hash and a single byte for the four members
+    ASSERT_EQ(delta.size(), sizeof(std::size_t) + 1u);
+    ASSERT_EQ(delta.back(), std::byte{});
+
+    ASSERT_TRUE(meta::patch(type, from, delta.data(), delta.size()));
+    ASSERT_EQ(from.base, 1);
+    ASSERT_EQ(from.pod.i, 2);
+    ASSERT_EQ(from.inner, to.inner);
+    ASSERT_EQ(from.get(), 5);
+}
+
+
+TEST_F(Delta, Functionalities) {
+    const auto type = meta::resolve<delta_record_type>();
+    auto from = record();
+    auto to = record();
+
+    to.base = 42;
+    to.pod.d = 1.5;
+    to.set(7);
+
+    const auto delta = meta::diff(type, from, to);
+    meta::serializer serializer{};
+
+    ASSERT_TRUE(serializer.write(to));
+    ASSERT_EQ(delta.size(), sizeof(std::size_t) + 1u + sizeof(common_pod_type) + sizeof(int) + sizeof(int));
+    ASSERT_LT(delta.size(), serializer.size());
+
+    ASSERT_TRUE(meta::patch(type, from, delta.data(), delta.size()));
+    ASSERT_EQ(from.base, 42);
+    ASSERT_EQ(from.pod.i, 2);
+    ASSERT_EQ(from.pod.d, 1.5);
+    ASSERT_EQ(from.inner, to.inner);
+    ASSERT_EQ(from.get(), 7);
+
+    ASSERT_EQ(meta::diff(type, from, to).size(), sizeof(std::size_t) + 1u);
+}
+
+
+TEST_F(Delta, Paddings) {
+    const auto type = meta::resolve<delta_record_type>();
+    auto from = record();
+    auto to = record();
+
+    // paddings of trivially copyable members don't make them differ
+    std::memset(&from.pod, 0x00, sizeof(from.pod));
+    std::memset(&to.pod, 0xff, sizeof(to.pod));
+
+    for(auto *pod: {&from.pod, &to.pod}) {
+        pod->i = 2;
+        pod->c = 'a';
+        pod->d = .5;
+    }
+
+    ASSERT_EQ(meta::diff(type, from, to).size(), sizeof(std::size_t) + 1u);
+}
+
+
+TEST_F(Delta, Nested) {
+    const auto type = meta::resolve<delta_record_type>();
+    auto from = record();
+    auto to = record();
+
+    to.inner.y = 42;
+
+    // only the changed member of the nested object is part of the delta
+    const auto delta = meta::diff(type, from, to);
+
+    ASSERT_EQ(delta.size(), sizeof(std::size_t) + 1u + 1u + sizeof(int));
+    ASSERT_TRUE(meta::patch(type, from, delta.data(), delta.size()));
+    ASSERT_EQ(from.inner.x, 3);
+    ASSERT_EQ(from.inner.y, 42);
+}
+
+
+TEST_F(Delta, Invalid) {
+    const auto type = meta::resolve<delta_record_type>();
+    auto from = record();
+    auto to = record();
+    common_pod_type pod{};
+    int value{};
+
+    to.pod.i = 42;
+    to.base = 7;
+
+    ASSERT_TRUE(meta::diff(type, from, pod).empty());
+    ASSERT_TRUE(meta::diff(type, meta::handle{}, to).empty());
+    ASSERT_TRUE(meta::diff(meta::type{}, from, to).empty());
+    ASSERT_TRUE(meta::diff(meta::resolve<int>(), value, value).empty());
+
+    const auto delta = meta::diff(type, from, to);
+    auto other = delta;
+    auto longer = delta;
+    other.front() ^= std::byte{1u};
+    longer.push_back(std::byte{});
+
+    ASSERT_FALSE(delta.empty());
+    ASSERT_FALSE(meta::patch(type, from, delta.data(), delta.size() - 1u));
+    ASSERT_FALSE(meta::patch(type, from, longer.data(), longer.size()));
+
+    // truncated deltas are rejected before anything is written
+    ASSERT_EQ(from.pod.i, 2);
+    ASSERT_EQ(from.base, 1);
+
+    ASSERT_FALSE(meta::patch(type, from, other.data(), other.size()));
+    ASSERT_FALSE(meta::patch(type, pod, delta.data(), delta.size()));
+    ASSERT_FALSE(meta::patch(meta::resolve<common_pod_type>(), pod, delta.data(), delta.size()));
+    ASSERT_TRUE(meta::patch(type, from, delta.data(), delta.size()));
+    ASSERT_EQ(from.pod.i, 42);
+    ASSERT_EQ(from.base, 7);
+}
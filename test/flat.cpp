@@ -0,0 +1,178 @@
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <meta/factory.hpp>
+#include <meta/flat.hpp>
+#include <meta/hashed_string.hpp>
+#include <meta/meta.hpp>
+
+struct flat_point_type {
+    double x;
+    double y;
+};
+
+
+struct flat_record_type {
+    int id;
+    flat_point_type position;
+    meta::flat_span<char> name;
+    meta::flat_span<flat_point_type> path;
+};
+
+
+struct flat_pointer_type {
+    int *ptr;
+};
+
+
+struct flat_other_type {
+    int id;
+};
+
+
+struct flat_derived_type: flat_other_type, flat_record_type {
+    meta::flat_span<char> tag;
+};
+
+
+struct Flat: ::testing::Test {
+    static void SetUpTestCase() {
+        meta::reflect<flat_point_type>("flat_point"_hs)
+                .data<&flat_point_type::x>("x"_hs)
+                .data<&flat_point_type::y>("y"_hs);
+
+        meta::reflect<flat_record_type>("flat_record"_hs)
+                .data<&flat_record_type::id>("id"_hs)
+                .data<&flat_record_type::position>("position"_hs)
+                .data<&flat_record_type::name>("name"_hs)
+                .data<&flat_record_type::path>("path"_hs);
+
+        meta::reflect<flat_pointer_type>("flat_pointer"_hs)
+                .data<&flat_pointer_type::ptr>("ptr"_hs);
+
+        meta::reflect<flat_other_type>("flat_other"_hs)
+                .data<&flat_other_type::id>("id"_hs);
+
+        meta::reflect<flat_derived_type>("flat_derived"_hs)
+                .base<flat_other_type>()
+                .base<flat_record_type>()
+                .data<&flat_derived_type::tag>("tag"_hs);
+    }
+
+    // images are meant to be mapped, copies are aligned as a mapping would be
+    static std::vector<std::max_align_t> load(const std::vector<std::byte> &image) {
+        std::vector<std::max_align_t> storage(image.size() / sizeof(std::max_align_t) + 1u);
+        std::memcpy(storage.data(), image.data(), image.size());
+        return storage;
+    }
+};
+
+
+TEST_F(Flat, Functionalities) {
+    meta::flat_writer writer{};
+    const flat_point_type path[]{{1., 2.}, {3., 4.}};
+
+    for(auto i = 0; i < 3; ++i) {
+        flat_record_type record{i, {i * 1., i * 2.}, writer.span(i ? "bar" : "foo"), writer.span(path, i)};
+        ASSERT_TRUE(writer.add(record));
+    }
+
+    const auto image = writer.release();
+    const auto storage = load(image);
+    meta::flat_view view{meta::resolve<flat_record_type>(), storage.data(), image.size()};
+
+    ASSERT_TRUE(view);
+    ASSERT_EQ(view.size(), 3u);
+
+    for(auto i = 0u; i < view.size(); ++i) {
+        const auto handle = view[i];
+
+        ASSERT_EQ(handle.type(), meta::resolve<flat_record_type>());
+
+        const auto &record = *static_cast<const flat_record_type *>(handle.data());
+
+        ASSERT_EQ(record.id, static_cast<int>(i));
+        ASSERT_EQ(record.position.y, i * 2.);
+        ASSERT_EQ((std::string_view{record.name.data(), record.name.size()}), (i ? "bar" : "foo"));
+        ASSERT_EQ(record.path.size(), i);
+
+        for(auto j = 0u; j < record.path.size(); ++j) {
+            ASSERT_EQ(record.path[j].x, path[j].x);
+            ASSERT_EQ(record.path[j].y, path[j].y);
+        }
+    }
+
+    ASSERT_EQ(meta::resolve<flat_record_type>().data("id"_hs).get(view[2u]).cast<int>(), 2);
+}
+
+
+TEST_F(Flat, Bounds) {
+    meta::flat_writer writer{};
+    flat_record_type record{};
+
+    record.name = writer.span("name");
+    ASSERT_TRUE(writer.add(record));
+
+    auto image = writer.release();
+    auto storage = load(image);
+    meta::flat_view view{meta::resolve<flat_record_type>(), storage.data(), image.size()};
+    auto &elem = *static_cast<flat_record_type *>(view[0u].data());
+
+    ASSERT_EQ(view.data(elem.name), elem.name.data());
+    ASSERT_EQ(view.data(elem.path), nullptr);
+    ASSERT_EQ(view.data(record.name), nullptr);
+
+    // corrupted spans point outside of the image
+    elem.name.count = image.size();
+    ASSERT_EQ(view.data(elem.name), nullptr);
+
+    elem.name.count = 1u;
+    elem.name.offset = -static_cast<std::int64_t>(image.size());
+    ASSERT_EQ(view.data(elem.name), nullptr);
+}
+
+
+TEST_F(Flat, Bases) {
+    meta::flat_writer writer{};
+    flat_derived_type derived{};
+
+    // spans of the base class are found at the offset of the base
+    derived.name = writer.span("name");
+    derived.tag = writer.span("tag");
+
+    ASSERT_TRUE(writer.add(derived));
+
+    const auto image = writer.release();
+    const auto storage = load(image);
+    meta::flat_view view{meta::resolve<flat_derived_type>(), storage.data(), image.size()};
+
+    ASSERT_TRUE(view);
+
+    const auto &record = *static_cast<const flat_derived_type *>(view[0u].data());
+
+    ASSERT_EQ((std::string_view{record.name.data(), record.name.size()}), "name");
+    ASSERT_EQ((std::string_view{record.tag.data(), record.tag.size()}), "tag");
+}
+
+
+TEST_F(Flat, Invalid) {
+    meta::flat_writer writer{};
+    flat_pointer_type pointer{};
+    flat_other_type other{};
+    flat_record_type record{};
+
+    ASSERT_FALSE(writer.add(pointer));
+    ASSERT_TRUE(writer.add(other));
+    ASSERT_FALSE(writer.add(record));
+
+    const auto image = writer.release();
+    const auto storage = load(image);
+
+    ASSERT_TRUE((meta::flat_view{meta::resolve<flat_other_type>(), storage.data(), image.size()}));
+    ASSERT_FALSE((meta::flat_view{meta::resolve<flat_record_type>(), storage.data(), image.size()}));
+    ASSERT_FALSE((meta::flat_view{meta::resolve<flat_other_type>(), storage.data(), image.size() / 2u}));
+    ASSERT_FALSE((meta::flat_view{meta::resolve<flat_other_type>(), nullptr, 0u}));
+    ASSERT_FALSE(meta::flat_view{});
+}
@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <type_traits>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <meta/hashed_string.hpp>
+
+constexpr bool ptr(const char *str) {
+    using hash_type = meta::hashed_string::hash_type;
+
+    return (static_cast<hash_type>(meta::hashed_string{str}) == meta::hashed_string{"foo"}
+            && std::string_view{meta::hashed_string{str}.data()} == "foo"
+            && meta::hashed_string{str} == meta::hashed_string{"foo"});
+}
+
+template<meta::hashed_string::hash_type Value>
+constexpr bool ref(const char (&str)[4]) {
+    return (meta::hashed_string::value(str) == Value
+            && meta::hashed_string{str}.value() == Value
+            && meta::hashed_string{str} == Value);
+}
+
+TEST(HashedString, Functionalities) {
+    using hash_type = meta::hashed_string::hash_type;
+
+    const char *bar = "bar";
+
+    auto foo_hs = meta::hashed_string{"foo"};
+    auto bar_hs = meta::hashed_string{bar};
+
+    ASSERT_NE(static_cast<hash_type>(foo_hs), static_cast<hash_type>(bar_hs));
+    ASSERT_EQ(std::string_view{foo_hs.data()}, "foo");
+    ASSERT_EQ(std::string_view{bar_hs.data()}, bar);
+
+    ASSERT_TRUE(foo_hs == foo_hs);
+    ASSERT_TRUE(foo_hs != bar_hs);
+
+    meta::hashed_string hs{"foobar"};
+
+    ASSERT_EQ(hs.value(), meta::hashed_string::value("foobar"));
+    ASSERT_EQ(meta::hashed_string{}.value(), hash_type{});
+    ASSERT_EQ(meta::hashed_string{}.data(), nullptr);
+}
+
+TEST(HashedString, FNV1a) {
+    if constexpr(sizeof(meta::hashed_string::hash_type) == 8u) {
+        ASSERT_EQ(meta::hashed_string::value(""), 0xcbf29ce484222325ull);
+        ASSERT_EQ(meta::hashed_string::value("a"), 0xaf63dc4c8601ec8cull);
+        ASSERT_EQ(meta::hashed_string::value("foobar"), 0x85944171f73967e8ull);
+    } else {
+        ASSERT_EQ(meta::hashed_string::value(""), 0x811c9dc5u);
+        ASSERT_EQ(meta::hashed_string::value("a"), 0xe40c292cu);
+        ASSERT_EQ(meta::hashed_string::value("foobar"), 0xbf9cf968u);
+    }
+}
+
+TEST(HashedString, Constexprness) {
+    using hash_type = meta::hashed_string::hash_type;
+
+    static_assert(ptr("foo"));
+    static_assert(ref<meta::hashed_string::value("foo")>("foo"));
+    static_assert(std::is_same_v<decltype("foo"_hs), meta::hashed_string>);
+    static_assert(static_cast<hash_type>("foo"_hs) == meta::hashed_string::value("foo"));
+    static_assert("foo"_hs != "bar"_hs);
+
+    std::integral_constant<hash_type, "foo"_hs> constant{};
+    ASSERT_EQ(constant.value, meta::hashed_string{"foo"}.value());
+}
@@ -0,0 +1,183 @@
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <meta/factory.hpp>
+#include <meta/hashed_string.hpp>
+#include <meta/json.hpp>
+#include <meta/meta.hpp>
+#include "common/types.hpp"
+
+struct json_point_type {
+    int x;
+    double y;
+};
+
+
+struct json_record_type: common_base_type, common_accessor_type {
+    std::string name;
+    bool enabled;
+    json_point_type position;
+    unsigned long long count;
+};
+
+
+struct json_opaque_type {
+    std::string_view view;
+};
+
+
+struct Json: ::testing::Test {
+    static void SetUpTestCase() {
+        reflect_common_types();
+
+        meta::reflect<json_point_type>("json_point"_hs)
+                .data<&json_point_type::x>("x"_hs)
+                .data<&json_point_type::y>("y"_hs);
+
+        meta::reflect<json_record_type>("json_record"_hs)
+                .base<common_base_type>()
+                .data<&json_record_type::name>("name"_hs)
+                .data<&json_record_type::enabled>("enabled"_hs)
+                .data<&json_record_type::position>("position"_hs)
+                .data<&json_record_type::count>("count"_hs)
+                .data<&json_record_type::set, &json_record_type::get>("value"_hs);
+
+        meta::reflect<json_opaque_type>("json_opaque"_hs)
+                .data<&json_opaque_type::view>("view"_hs);
+    }
+};
+
+
+TEST_F(Json, Writer) {
+    meta::json_writer writer{};
+    json_record_type record{};
+
+    record.base = 42;
+    record.name = "a \"quoted\"\nname";
+    record.enabled = true;
+    record.position = {-3, .5};
+    record.count = 18446744073709551615ull;
+    record.set(7);
+
+    ASSERT_TRUE(writer.write(record));
+    ASSERT_EQ(writer.str(), std::string_view{R"({"name":"a \"quoted\"\nname","enabled":true,"position":{"x":-3,"y":0.5},"count":18446744073709551615,"value":7,"base":42})"});
+
+    writer.clear();
+    int value = 3;
+
+    ASSERT_TRUE(writer.write(value));
+    ASSERT_EQ(writer.str(), "3");
+}
+
+
+TEST_F(Json, Reader) {
+    meta::json_reader reader{R"( { "base": 1, "unknown": {"nested": [1, "]", {}]}, "name": "café \"x\"", "enabled": false,
+        "position": { "y": 1.25e1, "x": 4 }, "count": null, "value": 9 } )"};
+
+    json_record_type record{};
+    record.count = 5u;
+
+    ASSERT_TRUE(reader.read(record));
+    ASSERT_EQ(record.base, 1);
+    ASSERT_EQ(record.name, "caf\xc3\xa9 \"x\"");
+    ASSERT_FALSE(record.enabled);
+    ASSERT_EQ(record.position.x, 4);
+    ASSERT_EQ(record.position.y, 12.5);
+    ASSERT_EQ(record.count, 5u);
+    ASSERT_EQ(record.get(), 9);
+    ASSERT_EQ(record.value, 18);
+}
+
+
+TEST_F(Json, RoundTrip) {
+    meta::json_writer writer{};
+    json_record_type record{};
+
+    record.base = 7;
+    record.name = "\t\x01";
+    record.position = {1, 0.1};
+    record.set(-4);
+
+    ASSERT_TRUE(writer.write(record));
+
+    json_record_type other{};
+    meta::json_reader reader{writer.str()};
+
+    ASSERT_TRUE(reader.read(other));
+    ASSERT_EQ(other.base, record.base);
+    ASSERT_EQ(other.name, record.name);
+    ASSERT_EQ(other.position.y, record.position.y);
+    ASSERT_EQ(other.get(), -4);
+    ASSERT_EQ(reader.size(), 0u);
+}
+
+
+TEST_F(Json, Arrays) {
+    meta::json_writer writer{};
+    std::string output{};
+
+    writer.begin_array();
+
+    for(auto i = 0; i < 4; ++i) {
+        json_point_type point{i, i * .5};
+        ASSERT_TRUE(writer.write(point));
+
+        // the output can be flushed between two values
+        output += writer.str();
+        writer.clear();
+    }
+
+    writer.end_array();
+    output += writer.str();
+
+    ASSERT_EQ(output, std::string_view{R"([{"x":0,"y":0},{"x":1,"y":0.5},{"x":2,"y":1},{"x":3,"y":1.5}])"});
+
+    meta::json_reader reader{output};
+    json_point_type point{};
+    int count{};
+
+    ASSERT_TRUE(reader.begin_array());
+
+    while(reader.next()) {
+        ASSERT_TRUE(reader.read(point));
+        ASSERT_EQ(point.x, count);
+        ASSERT_EQ(point.y, count * .5);
+        ++count;
+    }
+
+    ASSERT_EQ(count, 4);
+    ASSERT_EQ(reader.size(), 0u);
+}
+
+
+TEST_F(Json, Invalid) {
+    meta::json_writer writer{};
+    json_opaque_type opaque{};
+    json_point_type point{};
+
+    ASSERT_FALSE(writer.write(opaque));
+    ASSERT_FALSE(writer.write(meta::handle{}));
+    ASSERT_TRUE(writer.str().empty());
+
+    meta::json_reader reader{R"({"x": "1"} {"x": 1, "y": [)"};
+
+    ASSERT_FALSE(reader.read(point));
+    ASSERT_TRUE(reader.skip());
+    ASSERT_FALSE(reader.read(point));
+    ASSERT_FALSE(reader.skip());
+}
+
+
+TEST_F(Json, Surrogates) {
+    json_record_type record{};
+
+    ASSERT_TRUE(meta::json_reader{R"({"name": "\ud83d\ude00"})"}.read(record));
+    ASSERT_EQ(record.name, "\xf0\x9f\x98\x80");
+
+    // unpaired or malformed surrogates are rejected
+    ASSERT_FALSE(meta::json_reader{R"({"name": "\ud800\u0041"})"}.read(record));
+    ASSERT_FALSE(meta::json_reader{R"({"name": "\ud800\uzzzzB"})"}.read(record));
+    ASSERT_FALSE(meta::json_reader{R"({"name": "\ud800"})"}.read(record));
+    ASSERT_FALSE(meta::json_reader{R"({"name": "\udc00"})"}.read(record));
+    ASSERT_FALSE(meta::json_reader{R"({"name": "\uzzzz"})"}.read(record));
+}
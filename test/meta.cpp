@@ -1,9 +1,16 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
 #include <utility>
 #include <functional>
 #include <type_traits>
 #include <string_view>
+#include <unordered_set>
 #include <gtest/gtest.h>
 #include <meta/factory.hpp>
+#include <meta/hashed_string.hpp>
 #include <meta/meta.hpp>
 #include <meta/policy.hpp>
 
@@ -141,6 +148,140 @@ struct concrete_type: an_abstract_type, another_abstract_type {
     void h(char c) override { j = c; }
 };
 
+struct epoch_type {
+    int value{};
+};
+
+struct context_type {
+    int value{};
+};
+
+struct descriptor_type: base_type {
+    descriptor_type() = default;
+    descriptor_type(int v): value{v} {}
+
+    int twice() const { return 2 * value; }
+
+    int value{};
+    int other{};
+    int extra{};
+};
+
+struct hashed_type {
+    int get() const { return value; }
+    void set(int v) { value = v; }
+
+    int value{};
+};
+
+struct lazy_type {
+    inline static std::atomic<int> counter{};
+    int value{};
+};
+
+struct lazy_other_type {};
+
+struct frozen_base_type {
+    int base{};
+};
+
+struct frozen_type: frozen_base_type {
+    int get() const { return value; }
+
+    int value{};
+    int other{};
+};
+
+struct closure_base_type {
+    int base{};
+};
+
+struct closure_middle_type: closure_base_type {};
+
+struct closure_type: closure_middle_type {};
+
+struct poly_base_type {
+    virtual ~poly_base_type() = default;
+    int base{};
+};
+
+struct poly_other_type {
+    virtual ~poly_other_type() = default;
+};
+
+struct poly_derived_type: poly_base_type, poly_other_type {
+    int value{};
+};
+
+struct poly_unregistered_type: poly_derived_type {};
+
+struct poly_leaf_type: poly_derived_type {};
+
+struct poly_unregistered_leaf_type: poly_leaf_type {};
+
+struct dispatch_base_type {
+    int get() const { return 1; }
+    int base() const { return 2; }
+};
+
+struct dispatch_type: dispatch_base_type {
+    int get() const { return 3; }
+};
+
+struct dispatch_other_type {
+    int other() const { return 4; }
+};
+
+struct prop_type {};
+
+struct diamond_base_type {
+    int base{};
+};
+
+struct diamond_left_type: virtual diamond_base_type {
+    int left{};
+};
+
+struct diamond_right_type: virtual diamond_base_type {
+    int right{};
+};
+
+struct diamond_type: diamond_left_type, diamond_right_type {
+    int get() const { return value; }
+
+    int value{};
+};
+
+struct tagged_type {
+    int get() const { return value; }
+
+    int value{};
+    int other{};
+};
+
+struct cached_type {
+    bool operator==(const cached_type &other) const {
+        return value == other.value;
+    }
+
+    int value{};
+    int cache{};
+};
+
+template<std::size_t>
+struct many_type {};
+
+enum class many_enum: std::size_t {};
+
+using descriptor_desc = meta::descriptor<
+    descriptor_type, 1u,
+    meta::static_base<base_type>,
+    meta::static_ctor<int>,
+    meta::static_data<&descriptor_type::value, 2u>,
+    meta::static_data<&descriptor_type::other, 3u, meta::as_void_t>,
+    meta::static_func<&descriptor_type::twice, 4u>
+>;
+
 struct Meta: public ::testing::Test {
     static void SetUpTestCase() {
         meta::reflect<double>().conv<int>();
@@ -1703,6 +1844,18 @@ TEST_F(Meta, MetaTypeTraits) {
     ASSERT_TRUE(meta::resolve<decltype(&empty_type::destroy)>().is_function_pointer());
     ASSERT_TRUE(meta::resolve<decltype(&data_type::i)>().is_member_object_pointer());
     ASSERT_TRUE(meta::resolve<decltype(&func_type::g)>().is_member_function_pointer());
+
+    ASSERT_EQ(meta::resolve<void>().traits(), meta::traits::is_void);
+    ASSERT_EQ(meta::resolve<int *>().traits(), meta::traits::is_pointer | meta::traits::is_trivially_copyable);
+    ASSERT_EQ(meta::resolve<decltype(&empty_type::destroy)>().traits(), meta::traits::is_pointer | meta::traits::is_function_pointer | meta::traits::is_trivially_copyable);
+    ASSERT_TRUE(meta::resolve<array_type>().is(meta::traits::is_trivially_copyable));
+    ASSERT_FALSE(meta::resolve<std::string>().is(meta::traits::is_trivially_copyable));
+
+    ASSERT_TRUE(meta::resolve<double>().is(meta::traits::is_integral | meta::traits::is_floating_point));
+    ASSERT_TRUE(meta::resolve<bool>().is(meta::traits::is_integral | meta::traits::is_floating_point));
+    ASSERT_FALSE(meta::resolve<derived_type>().is(meta::traits::is_integral | meta::traits::is_floating_point));
+    ASSERT_FALSE(meta::resolve<derived_type>().is(meta::traits::none));
+    ASSERT_FALSE(meta::resolve<properties>().is(~(meta::traits::is_enum | meta::traits::is_trivially_copyable)));
 }
 
 TEST_F(Meta, MetaTypeRemovePointer) {
@@ -1997,6 +2150,787 @@ TEST_F(Meta, Variables) {
     ASSERT_EQ(c, 'x');
 }
 
+TEST_F(Meta, Context) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+    meta::context other{};
+    int counter{};
+
+    meta::reflect<context_type>(ctx, hash("context"))
+            .data<&context_type::value>(hash("value"));
+
+    ASSERT_FALSE(meta::resolve(hash("context")));
+    ASSERT_FALSE(meta::resolve(other, hash("context")));
+    ASSERT_FALSE(meta::resolve(ctx, hash("derived")));
+    ASSERT_EQ(meta::resolve(ctx, hash("context")), meta::resolve<context_type>());
+    ASSERT_EQ(meta::resolve<context_type>(ctx), meta::resolve<context_type>());
+    ASSERT_FALSE(meta::resolve<context_type>(other));
+    ASSERT_TRUE(meta::resolve(ctx, hash("context")).data(hash("value")));
+
+    meta::resolve(ctx, [&counter](auto type) {
+        ASSERT_EQ(type, meta::resolve<context_type>());
+        ++counter;
+    });
+
+    meta::resolve([](auto type) {
+        ASSERT_NE(type, meta::resolve<context_type>());
+    });
+
+    ASSERT_EQ(counter, 1);
+    ASSERT_FALSE(meta::unregister<context_type>(other));
+    ASSERT_TRUE(meta::unregister<context_type>(ctx));
+    ASSERT_FALSE(meta::resolve(ctx, hash("context")));
+
+    meta::reflect<context_type>(other, hash("context"))
+            .data<&context_type::value>(hash("value"));
+
+    ASSERT_EQ(meta::resolve(other, hash("context")), meta::resolve<context_type>());
+    ASSERT_FALSE(meta::resolve<context_type>(ctx));
+}
+
+TEST_F(Meta, ContextParallelRegistration) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx[2u]{};
+    std::thread writers[2u]{};
+
+    for(auto i = 0u; i < 2u; ++i) {
+        writers[i] = std::thread{[&ctx, hash, i]() {
+            for(auto j = 0; j < 100; ++j) {
+                if(i == 0u) {
+                    meta::reflect<context_type>(ctx[i], hash("context")).data<&context_type::value>(hash("value"));
+                    ASSERT_TRUE(meta::unregister<context_type>(ctx[i]));
+                } else {
+                    meta::reflect<epoch_type>(ctx[i], hash("epoch")).data<&epoch_type::value>(hash("value"));
+                    ASSERT_TRUE(meta::unregister<epoch_type>(ctx[i]));
+                }
+            }
+        }};
+    }
+
+    for(auto &&writer: writers) {
+        writer.join();
+    }
+
+    ASSERT_FALSE(meta::resolve<context_type>(ctx[0u]));
+    ASSERT_FALSE(meta::resolve<epoch_type>(ctx[1u]));
+}
+
+TEST_F(Meta, ContextDestruction) {
+    std::hash<std::string_view> hash{};
+
+    {
+        meta::context ctx{};
+        meta::reflect<context_type>(ctx, hash("context"))
+                .data<&context_type::value>(hash("value"));
+
+        ASSERT_TRUE(meta::resolve<context_type>().data(hash("value")));
+    }
+
+    ASSERT_FALSE(meta::resolve<context_type>().data(hash("value")));
+}
+
+TEST_F(Meta, LookupCacheInvalidation) {
+    std::hash<std::string_view> hash{};
+
+    for(auto i = 0; i < 3; ++i) {
+        ASSERT_FALSE(meta::resolve(hash("context")));
+        ASSERT_FALSE(meta::resolve<context_type>().data(hash("value")));
+        ASSERT_FALSE(meta::any{context_type{}}.try_cast<base_type>());
+    }
+
+    meta::reflect<context_type>(hash("context")).data<&context_type::value>(hash("value"));
+
+    ASSERT_EQ(meta::resolve(hash("context")), meta::resolve<context_type>());
+    ASSERT_TRUE(meta::resolve<context_type>().data(hash("value")));
+    ASSERT_TRUE(meta::unregister<context_type>());
+    ASSERT_FALSE(meta::resolve(hash("context")));
+    ASSERT_FALSE(meta::resolve<context_type>().data(hash("value")));
+
+    meta::reflect<context_type>(hash("other")).func<&derived_type::g>(hash("value"));
+
+    ASSERT_FALSE(meta::resolve(hash("context")));
+    ASSERT_EQ(meta::resolve(hash("other")), meta::resolve<context_type>());
+    ASSERT_FALSE(meta::resolve<context_type>().data(hash("value")));
+    ASSERT_TRUE(meta::resolve<context_type>().func(hash("value")));
+    ASSERT_TRUE(meta::unregister<context_type>());
+}
+
+TEST_F(Meta, UnregisterWaitsForReaders) {
+    std::hash<std::string_view> hash{};
+    std::atomic<bool> done{false};
+    std::thread writer{};
+
+    meta::reflect<epoch_type>(hash("epoch")).data<&epoch_type::value>(hash("value"));
+
+    {
+        meta::read_guard guard{};
+        auto type = meta::resolve(hash("epoch"));
+        auto data = type.data(hash("value"));
+
+        writer = std::thread{[&done]() {
+            done = meta::unregister<epoch_type>();
+        }};
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+        EXPECT_FALSE(done);
+        EXPECT_TRUE(data);
+        EXPECT_EQ(data.type(), meta::resolve<int>());
+        EXPECT_EQ(data.parent(), type);
+    }
+
+    writer.join();
+
+    ASSERT_TRUE(done);
+    ASSERT_FALSE(meta::resolve(hash("epoch")));
+}
+
+TEST_F(Meta, UnregisterWithConcurrentReaders) {
+    std::hash<std::string_view> hash{};
+    std::atomic<bool> stop{false};
+
+    std::thread reader{[&stop, hash]() {
+        while(!stop) {
+            meta::read_guard guard{};
+
+            meta::resolve([](auto type) {
+                type.data([](auto data) {
+                    ASSERT_TRUE(data.type());
+                });
+            });
+
+            if(auto type = meta::resolve(hash("epoch")); type) {
+                ASSERT_TRUE(type.is_class());
+            }
+        }
+    }};
+
+    for(auto i = 0; i < 100; ++i) {
+        meta::reflect<epoch_type>(hash("epoch")).data<&epoch_type::value>(hash("value"));
+        ASSERT_TRUE(meta::unregister<epoch_type>());
+    }
+
+    stop = true;
+    reader.join();
+}
+
+TEST_F(Meta, Descriptor) {
+    meta::reflect(descriptor_desc{}).data<&descriptor_type::extra>(5u);
+
+    const auto type = meta::resolve(1u);
+
+    ASSERT_EQ(type, meta::resolve<descriptor_type>());
+    ASSERT_EQ(type.base(std::hash<std::string_view>{}("base")).type(), meta::resolve<base_type>());
+    ASSERT_EQ(type.data(2u).parent(), type);
+    ASSERT_EQ(type.data(3u).type(), meta::resolve<int>());
+    ASSERT_EQ(type.data(5u).type(), meta::resolve<int>());
+    ASSERT_EQ(type.func(4u).parent(), type);
+
+    auto any = type.construct(21);
+    descriptor_type instance{};
+
+    ASSERT_TRUE(any);
+    ASSERT_EQ(any.cast<descriptor_type>().value, 21);
+    ASSERT_EQ(type.func(4u).invoke(any).cast<int>(), 42);
+    ASSERT_TRUE(type.data(2u).set(instance, 3));
+    ASSERT_EQ(instance.value, 3);
+    ASSERT_NE(any.try_cast<base_type>(), nullptr);
+
+    unsigned int count{};
+    type.data([&count](auto) { ++count; });
+    ASSERT_EQ(count, 3u);
+
+    ASSERT_TRUE(meta::unregister<descriptor_type>());
+    ASSERT_FALSE(meta::resolve(1u));
+    ASSERT_FALSE(type.data(2u));
+
+    meta::context ctx{};
+    meta::reflect(ctx, descriptor_desc{});
+
+    count = {};
+    meta::resolve(ctx, 1u).data([&count](auto) { ++count; });
+
+    ASSERT_FALSE(meta::resolve(1u));
+    ASSERT_EQ(meta::resolve(ctx, 1u), meta::resolve<descriptor_type>());
+    ASSERT_TRUE(meta::resolve(ctx, 1u).func(4u));
+    ASSERT_FALSE(meta::resolve(ctx, 1u).data(5u));
+    ASSERT_EQ(count, 2u);
+
+    ASSERT_TRUE(meta::unregister<descriptor_type>());
+
+    // links to members of previous registrations don't survive
+    meta::reflect(descriptor_desc{}).data<&descriptor_type::extra>(5u);
+    ASSERT_TRUE(meta::unregister<descriptor_type>());
+    meta::reflect(descriptor_desc{});
+
+    count = {};
+    meta::resolve(1u).data([&count](auto) { ++count; });
+
+    ASSERT_EQ(count, 2u);
+    ASSERT_FALSE(meta::resolve(1u).data(5u));
+    ASSERT_TRUE(meta::unregister<descriptor_type>());
+}
+
+TEST_F(Meta, Defer) {
+    std::hash<std::string_view> hash{};
+    lazy_type::counter = 0;
+
+    meta::defer<lazy_type>(hash("lazy"), [](auto factory) {
+        factory.template data<&lazy_type::value>(std::hash<std::string_view>{}("value"));
+        ++lazy_type::counter;
+    });
+
+    ASSERT_EQ(lazy_type::counter, 0);
+    ASSERT_TRUE(meta::resolve(hash("lazy")).data(hash("value")));
+    ASSERT_EQ(lazy_type::counter, 1);
+    ASSERT_EQ(meta::resolve<lazy_type>(), meta::resolve(hash("lazy")));
+    ASSERT_EQ(lazy_type::counter, 1);
+    ASSERT_TRUE(meta::unregister<lazy_type>());
+
+    meta::defer<lazy_type>(hash("lazy"), [](auto) { ++lazy_type::counter; });
+
+    ASSERT_EQ(lazy_type::counter, 1);
+    ASSERT_TRUE(meta::unregister<lazy_type>());
+    ASSERT_EQ(lazy_type::counter, 1);
+    ASSERT_FALSE(meta::resolve(hash("lazy")));
+}
+
+TEST_F(Meta, DeferWithConcurrentReaders) {
+    std::hash<std::string_view> hash{};
+    std::atomic<bool> start{};
+    std::thread readers[4u];
+    std::atomic<int> found{};
+    lazy_type::counter = 0;
+
+    meta::defer<lazy_type>(hash("lazy"), [](auto factory) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        factory.template data<&lazy_type::value>(std::hash<std::string_view>{}("value"));
+        ++lazy_type::counter;
+    });
+
+    for(auto &&reader: readers) {
+        reader = std::thread{[&]() {
+            while(!start) {
+                std::this_thread::yield();
+            }
+
+            found += static_cast<bool>(meta::any{lazy_type{}}.type().data(std::hash<std::string_view>{}("value")));
+        }};
+    }
+
+    start = true;
+
+    for(auto &&reader: readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(lazy_type::counter, 1);
+    ASSERT_EQ(found, 4);
+    ASSERT_TRUE(meta::unregister<lazy_type>());
+}
+
+TEST_F(Meta, DeferWithoutLocks) {
+    std::hash<std::string_view> hash{};
+    lazy_type::counter = 0;
+
+    // callbacks can wait for other threads that register types
+    meta::defer<lazy_type>(hash("lazy"), [](auto) {
+        std::thread{[]() {
+            meta::reflect<lazy_other_type>(std::hash<std::string_view>{}("lazy_other"), std::make_pair(properties::prop_int, 0));
+        }}.join();
+
+        ++lazy_type::counter;
+    });
+
+    ASSERT_TRUE(meta::resolve(hash("lazy")));
+    ASSERT_EQ(lazy_type::counter, 1);
+    ASSERT_TRUE(meta::resolve(hash("lazy_other")).prop(properties::prop_int));
+    ASSERT_TRUE(meta::unregister<lazy_other_type>());
+    ASSERT_TRUE(meta::unregister<lazy_type>());
+}
+
+TEST_F(Meta, Freeze) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+
+    meta::reflect<frozen_base_type>(ctx, hash("frozen_base"))
+            .data<&frozen_base_type::base>(hash("base"));
+
+    meta::reflect<frozen_type>(ctx, hash("frozen"))
+            .base<frozen_base_type>()
+            .data<&frozen_type::value>(hash("value"))
+            .func<&frozen_type::get>(hash("get"));
+
+    meta::freeze(ctx);
+
+    const auto type = meta::resolve(ctx, hash("frozen"));
+    unsigned int count{};
+
+    ASSERT_EQ(type, meta::resolve<frozen_type>());
+    ASSERT_EQ(meta::resolve(ctx, hash("frozen_base")), meta::resolve<frozen_base_type>());
+    ASSERT_FALSE(meta::resolve(ctx, hash("derived")));
+    ASSERT_EQ(type.data(hash("value")).type(), meta::resolve<int>());
+    ASSERT_EQ(type.data(hash("base")).parent(), meta::resolve<frozen_base_type>());
+    ASSERT_FALSE(type.data(hash("other")));
+    ASSERT_TRUE(type.func(hash("get")));
+
+    type.data([&count](auto) { ++count; });
+    meta::resolve(ctx, [&count](auto) { ++count; });
+
+    ASSERT_EQ(count, 4u);
+
+    meta::reflect<frozen_type>().data<&frozen_type::other>(hash("other"));
+    count = {};
+    type.data([&count](auto) { ++count; });
+
+    ASSERT_TRUE(type.data(hash("other")));
+    ASSERT_EQ(count, 3u);
+    ASSERT_TRUE(meta::unregister<frozen_base_type>(ctx));
+    ASSERT_FALSE(meta::resolve(ctx, hash("frozen_base")));
+    ASSERT_FALSE(type.data(hash("base")));
+
+    meta::freeze(ctx);
+
+    ASSERT_EQ(meta::resolve(ctx, hash("frozen")), type);
+    ASSERT_TRUE(type.data(hash("other")));
+}
+
+TEST_F(Meta, FreezeGlobalRegistry) {
+    std::hash<std::string_view> hash{};
+
+    meta::freeze();
+
+    ASSERT_EQ(meta::resolve(hash("derived")), meta::resolve<derived_type>());
+    ASSERT_TRUE(meta::resolve(hash("data")).data(hash("i")));
+    ASSERT_TRUE(meta::resolve(hash("func")).func(hash("f1")));
+    ASSERT_FALSE(meta::resolve(hash("frozen")));
+}
+
+TEST_F(Meta, FreezePerfectHash) {
+    meta::context ctx{};
+
+    [&ctx](auto... index) {
+        (meta::reflect<many_type<decltype(index)::value>>(ctx, 1000u + decltype(index)::value), ...);
+        (meta::reflect<many_enum>().template data<many_enum{decltype(index)::value}>(2000u + decltype(index)::value), ...);
+    }(std::integral_constant<std::size_t, 0u>{}, std::integral_constant<std::size_t, 1u>{}, std::integral_constant<std::size_t, 2u>{},
+      std::integral_constant<std::size_t, 3u>{}, std::integral_constant<std::size_t, 4u>{}, std::integral_constant<std::size_t, 5u>{},
+      std::integral_constant<std::size_t, 6u>{}, std::integral_constant<std::size_t, 7u>{}, std::integral_constant<std::size_t, 8u>{},
+      std::integral_constant<std::size_t, 9u>{}, std::integral_constant<std::size_t, 10u>{}, std::integral_constant<std::size_t, 11u>{});
+
+    meta::reflect<many_enum>(ctx, 3000u);
+    meta::freeze(ctx);
+
+    for(std::size_t pos{}; pos < 12u; ++pos) {
+        ASSERT_TRUE(meta::resolve(ctx, 1000u + pos));
+        ASSERT_FALSE(meta::resolve(ctx, 1000u + pos).data(2000u));
+        ASSERT_EQ(meta::resolve(ctx, 3000u).data(2000u + pos).get({}).cast<many_enum>(), many_enum{pos});
+    }
+
+    ASSERT_FALSE(meta::resolve(ctx, 1012u));
+    ASSERT_FALSE(meta::resolve(ctx, 2000u));
+    ASSERT_FALSE(meta::resolve(ctx, 3000u).data(2012u));
+}
+
+TEST_F(Meta, HashedString) {
+    meta::reflect<hashed_type>("hashed"_hs)
+            .data<&hashed_type::value>("value"_hs)
+            .data<&hashed_type::set, &hashed_type::get>("accessor"_hs)
+            .func<&hashed_type::get>("get"_hs);
+
+    const auto type = meta::resolve("hashed"_hs);
+    hashed_type instance{};
+
+    ASSERT_EQ(type, meta::resolve<hashed_type>());
+    ASSERT_EQ(meta::resolve(meta::hashed_string::value("hashed")), type);
+    ASSERT_TRUE(type.data("value"_hs).set(instance, 42));
+    ASSERT_EQ(type.data("accessor"_hs).get(instance).cast<int>(), 42);
+    ASSERT_EQ(type.func("get"_hs).invoke(instance).cast<int>(), 42);
+    ASSERT_TRUE(meta::unregister<hashed_type>());
+
+    meta::context ctx{};
+    meta::reflect<hashed_type>(ctx, "hashed"_hs).data<&hashed_type::value>("value"_hs);
+
+    ASSERT_FALSE(meta::resolve("hashed"_hs));
+    ASSERT_TRUE(meta::resolve(ctx, "hashed"_hs).data("value"_hs));
+}
+
+TEST_F(Meta, Names) {
+    meta::context ctx{};
+
+    meta::reflect<hashed_type>(ctx, "hashed"_hs)
+            .data<&hashed_type::value>("value"_hs)
+            .func<&hashed_type::get>("get"_hs);
+
+    const auto type = meta::resolve(ctx, "hashed");
+
+    ASSERT_TRUE(type);
+    ASSERT_EQ(type.name(), "hashed");
+    ASSERT_EQ(type.data("value").name(), "value");
+    ASSERT_EQ(type.func("get").name(), "get");
+    ASSERT_EQ(type.data("value"), type.data("value"_hs));
+    ASSERT_FALSE(type.data("get"));
+    ASSERT_FALSE(type.func("value"));
+    ASSERT_FALSE(meta::resolve("hashed"));
+    ASSERT_FALSE(meta::resolve(ctx, "value"));
+    ASSERT_EQ(meta::resolve("derived"), meta::type{});
+    ASSERT_TRUE(meta::resolve<derived_type>().name().empty());
+
+    meta::freeze(ctx);
+
+    ASSERT_EQ(meta::resolve(ctx, "hashed"), type);
+    ASSERT_EQ(type.data("value").name(), "value");
+}
+
+TEST_F(Meta, IsDerivedFrom) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+
+    meta::reflect<closure_base_type>(ctx, hash("closure_base"));
+    meta::reflect<closure_middle_type>(ctx, hash("closure_middle")).base<closure_base_type>();
+    meta::reflect<closure_type>(ctx, hash("closure")).base<closure_middle_type>();
+
+    const auto check = [](const bool middle) {
+        const auto type = meta::resolve<closure_type>();
+        meta::any any{closure_type{}};
+
+        ASSERT_EQ(type.is_derived_from(meta::resolve<closure_base_type>()), middle);
+        ASSERT_TRUE(type.is_derived_from(meta::resolve<closure_middle_type>()));
+        ASSERT_EQ(meta::resolve<closure_middle_type>().is_derived_from(meta::resolve<closure_base_type>()), middle);
+        ASSERT_FALSE(meta::resolve<closure_base_type>().is_derived_from(type));
+        ASSERT_FALSE(type.is_derived_from(type));
+        ASSERT_FALSE(type.is_derived_from(meta::resolve<derived_type>()));
+        ASSERT_FALSE(type.is_derived_from({}));
+        ASSERT_EQ(any.try_cast<closure_base_type>() != nullptr, middle);
+        ASSERT_NE(any.try_cast<closure_middle_type>(), nullptr);
+        ASSERT_EQ(any.try_cast<base_type>(), nullptr);
+    };
+
+    check(true);
+    meta::freeze(ctx);
+    check(true);
+
+    ASSERT_TRUE(meta::unregister<closure_middle_type>(ctx));
+
+    check(false);
+    meta::freeze(ctx);
+    check(false);
+}
+
+TEST_F(Meta, Downcast) {
+    meta::context ctx{};
+
+    meta::reflect<poly_base_type>(ctx, 1u);
+    meta::reflect<poly_other_type>(ctx, 2u);
+    meta::reflect<poly_derived_type>(ctx, 3u).base<poly_base_type>().base<poly_other_type>();
+
+    poly_derived_type instance{};
+    poly_unregistered_type unregistered{};
+    poly_base_type plain{};
+    poly_base_type &base = instance;
+    poly_other_type &other = instance;
+    poly_base_type &actual = unregistered;
+    meta::any any{std::ref(base)};
+
+    ASSERT_EQ(any.type(), meta::resolve<poly_base_type>());
+    ASSERT_EQ(any.try_cast<poly_derived_type>(), &instance);
+    ASSERT_EQ(any.try_cast<poly_other_type>(), &other);
+    ASSERT_EQ(any.try_cast<derived_type>(), nullptr);
+    ASSERT_EQ(meta::any{std::ref(other)}.try_cast<poly_derived_type>(), &instance);
+    ASSERT_EQ(meta::any{std::ref(plain)}.try_cast<poly_derived_type>(), nullptr);
+    ASSERT_EQ(meta::any{std::ref(actual)}.try_cast<poly_derived_type>(), &unregistered);
+    ASSERT_EQ(meta::any{std::ref(actual)}.try_cast<poly_other_type>(), nullptr);
+
+    // the most derived type isn't known, the hierarchy of the target is walked
+    meta::reflect<poly_leaf_type>(ctx, 4u).base<poly_derived_type>();
+    poly_unregistered_leaf_type leaf{};
+    poly_base_type &deep = leaf;
+
+    ASSERT_EQ(meta::any{std::ref(deep)}.try_cast<poly_leaf_type>(), &leaf);
+    ASSERT_TRUE(meta::unregister<poly_leaf_type>(ctx));
+
+    meta::freeze(ctx);
+
+    ASSERT_EQ(any.try_cast<poly_derived_type>(), &instance);
+    ASSERT_EQ(any.try_cast<poly_other_type>(), &other);
+    ASSERT_TRUE(meta::unregister<poly_derived_type>(ctx));
+    ASSERT_EQ(any.try_cast<poly_derived_type>(), nullptr);
+    ASSERT_EQ(meta::any{std::ref(actual)}.try_cast<poly_derived_type>(), nullptr);
+}
+
+TEST_F(Meta, Dispatch) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+
+    meta::reflect<dispatch_base_type>(ctx, hash("dispatch_base"))
+            .func<&dispatch_base_type::get>(hash("get"))
+            .func<&dispatch_base_type::base>(hash("base"));
+
+    meta::reflect<dispatch_type>(ctx, hash("dispatch"))
+            .base<dispatch_base_type>()
+            .func<&dispatch_type::get>(hash("get"));
+
+    meta::reflect<dispatch_other_type>(ctx, hash("dispatch_other"))
+            .func<&dispatch_other_type::other>(hash("other"));
+
+    const meta::slot get{hash("get")};
+    const meta::slot base{hash("base")};
+    const meta::slot other{hash("other")};
+
+    const auto check = [&]() {
+        const auto type = meta::resolve<dispatch_type>();
+        dispatch_type instance{};
+
+        ASSERT_EQ(type.func(get), type.func(hash("get")));
+        ASSERT_EQ(type.func(get).parent(), type);
+        ASSERT_EQ(type.func(get).invoke(instance).cast<int>(), 3);
+        ASSERT_EQ(type.func(base).parent(), meta::resolve<dispatch_base_type>());
+        ASSERT_EQ(type.func(base).invoke(instance).cast<int>(), 2);
+        ASSERT_EQ(meta::resolve<dispatch_base_type>().func(get).parent(), meta::resolve<dispatch_base_type>());
+        ASSERT_EQ(meta::resolve<dispatch_other_type>().func(other).parent(), meta::resolve<dispatch_other_type>());
+        ASSERT_FALSE(type.func(other));
+        ASSERT_FALSE(meta::resolve<dispatch_other_type>().func(get));
+        ASSERT_FALSE(type.func(meta::slot{hash("none")}));
+    };
+
+    ASSERT_EQ(meta::slot{hash("get")}.index(), get.index());
+    ASSERT_NE(get.index(), base.index());
+    ASSERT_EQ(get.identifier(), hash("get"));
+
+    check();
+    meta::freeze(ctx);
+    check();
+}
+
+TEST_F(Meta, InlineCache) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+
+    meta::reflect<dispatch_base_type>(ctx, hash("dispatch_base"))
+            .func<&dispatch_base_type::get>(hash("get"));
+
+    meta::reflect<dispatch_type>(ctx, hash("dispatch"))
+            .base<dispatch_base_type>()
+            .func<&dispatch_type::get>(hash("get"));
+
+    meta::reflect<dispatch_other_type>(ctx, hash("dispatch_other"));
+
+    meta::inline_cache<meta::func> cache{hash("get")};
+    meta::inline_cache<meta::func, 2u> polymorphic{hash("get")};
+    meta::inline_cache<meta::data> data{hash("i")};
+    dispatch_base_type base{};
+    dispatch_type instance{};
+    meta::any any{instance};
+
+    ASSERT_EQ(cache(meta::resolve<dispatch_type>()), meta::resolve<dispatch_type>().func(hash("get")));
+    ASSERT_EQ(cache(meta::handle{instance}).parent(), meta::resolve<dispatch_type>());
+    ASSERT_EQ(cache(any).invoke(instance).cast<int>(), 3);
+    ASSERT_EQ(cache(meta::handle{base}).parent(), meta::resolve<dispatch_base_type>());
+    ASSERT_FALSE(cache(meta::resolve<dispatch_other_type>()));
+    ASSERT_FALSE(cache(meta::handle{}));
+    ASSERT_FALSE(cache(meta::any{}));
+
+    for(auto i = 0; i < 3; ++i) {
+        ASSERT_EQ(polymorphic(any).parent(), meta::resolve<dispatch_type>());
+        ASSERT_EQ(polymorphic(meta::handle{base}).parent(), meta::resolve<dispatch_base_type>());
+    }
+
+    ASSERT_EQ(data(meta::resolve<data_type>()), meta::resolve<data_type>().data(hash("i")));
+    ASSERT_FALSE(data(meta::resolve<dispatch_type>()));
+    ASSERT_TRUE(meta::unregister<dispatch_type>(ctx));
+    ASSERT_FALSE(cache(any));
+    ASSERT_FALSE(polymorphic(any));
+    ASSERT_TRUE(polymorphic(meta::handle{base}));
+}
+
+TEST_F(Meta, PropLookup) {
+    std::hash<std::string_view> hash{};
+    static const char key[] = "key";
+    meta::context ctx{};
+
+    meta::reflect<prop_type>(ctx, hash("prop"),
+            std::make_pair(properties::prop_int, 1),
+            std::make_pair(std::string{"name"}, 2),
+            std::make_pair(std::make_pair(3, 4), 5),
+            std::make_pair(key, 6));
+
+    const auto type = meta::resolve<prop_type>();
+
+    ASSERT_EQ(type.prop(properties::prop_int).value(), 1);
+    ASSERT_EQ(type.prop(std::string{"name"}).value(), 2);
+    ASSERT_EQ(type.prop(std::make_pair(3, 4)).value(), 5);
+    ASSERT_EQ(type.prop(key).value(), 6);
+    ASSERT_EQ(type.prop(static_cast<const char *>(key)).value(), 6);
+    ASSERT_FALSE(type.prop(properties::prop_bool));
+    ASSERT_FALSE(type.prop(0));
+    ASSERT_FALSE(type.prop(std::string{"other"}));
+    ASSERT_FALSE(type.prop(std::make_pair(4, 3)));
+}
+
+TEST_F(Meta, PropValueRef) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+
+    meta::reflect<prop_type>(ctx, hash("prop"), std::make_pair(properties::prop_int, std::string{"tooltip"}));
+
+    const auto prop = meta::resolve<prop_type>().prop(properties::prop_int);
+    const auto key = prop.key_ref();
+    const auto value = prop.value_ref();
+
+    ASSERT_EQ(key.type(), meta::resolve<properties>());
+    ASSERT_EQ(key.cast<properties>(), properties::prop_int);
+    ASSERT_EQ(value.type(), meta::resolve<std::string>());
+    ASSERT_EQ(value.cast<std::string>(), "tooltip");
+    ASSERT_EQ(value.try_cast<std::string>(), prop.value_ref().try_cast<std::string>());
+    ASSERT_NE(value.try_cast<std::string>(), prop.value().try_cast<std::string>());
+    ASSERT_EQ(value, prop.value());
+}
+
+TEST_F(Meta, Tagged) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+
+    meta::reflect<tagged_type>(ctx, hash("tagged"), std::make_pair(properties::prop_bool, true))
+            .data<&tagged_type::value>(hash("value"), std::make_pair(properties::prop_int, 1))
+            .data<&tagged_type::other>(hash("other"), std::make_pair(properties::prop_bool, false), std::make_pair(properties::prop_int, 2))
+            .func<&tagged_type::get>(hash("get"), std::make_pair(properties::prop_int, 3));
+
+    const auto type = meta::resolve<tagged_type>();
+    int data{};
+    int func{};
+    bool found{};
+
+    for(auto [curr, prop]: meta::tagged<meta::data>(ctx, properties::prop_int)) {
+        ASSERT_EQ(curr.parent(), type);
+        ASSERT_EQ(curr.prop(properties::prop_int), prop);
+        data += prop.value().cast<int>();
+    }
+
+    for(auto [curr, prop]: meta::tagged<meta::func>(ctx, properties::prop_int)) {
+        ASSERT_EQ(curr.parent(), type);
+        func += prop.value().cast<int>();
+    }
+
+    for(auto [curr, prop]: meta::tagged<meta::type>(ctx, properties::prop_bool)) {
+        found = found || (curr == type && prop.value().cast<bool>());
+    }
+
+    ASSERT_EQ(data, 3);
+    ASSERT_EQ(func, 3);
+    ASSERT_TRUE(found);
+
+    // properties are indexed per context
+    for(auto [curr, prop]: meta::tagged<meta::data>(properties::prop_int)) {
+        ASSERT_NE(curr.parent(), type);
+        ASSERT_TRUE(prop);
+    }
+
+    ASSERT_TRUE(meta::unregister<tagged_type>(ctx));
+    ASSERT_EQ(meta::tagged<meta::data>(ctx, properties::prop_int).begin(), meta::tagged<meta::data>(ctx, properties::prop_int).end());
+    ASSERT_EQ(meta::tagged<meta::type>(ctx, properties::prop_bool).begin(), meta::tagged<meta::type>(ctx, properties::prop_bool).end());
+}
+
+TEST_F(Meta, FlatMembers) {
+    std::hash<std::string_view> hash{};
+    meta::context ctx{};
+
+    meta::reflect<diamond_base_type>(ctx, hash("diamond_base")).data<&diamond_base_type::base>(hash("base"));
+    meta::reflect<diamond_left_type>(ctx, hash("diamond_left")).base<diamond_base_type>().data<&diamond_left_type::left>(hash("left"));
+    meta::reflect<diamond_right_type>(ctx, hash("diamond_right")).base<diamond_base_type>().data<&diamond_right_type::right>(hash("right"));
+
+    meta::reflect<diamond_type>(ctx, hash("diamond"))
+            .base<diamond_left_type>()
+            .base<diamond_right_type>()
+            .data<&diamond_type::value>(hash("value"))
+            .func<&diamond_type::get>(hash("get"));
+
+    const auto check = [&hash]() {
+        const auto type = meta::resolve<diamond_type>();
+        std::vector<meta::data> data{};
+        unsigned int func{};
+        diamond_type instance{};
+
+        type.data([&data](meta::data curr) { data.push_back(curr); });
+        type.func([&func](meta::func) { ++func; });
+
+        ASSERT_EQ(data.size(), 4u);
+        ASSERT_EQ(data[0u], type.data(hash("value")));
+        ASSERT_EQ(func, 1u);
+
+        for(auto &&curr: data) {
+            ASSERT_TRUE(curr.set(instance, 42));
+            ASSERT_EQ(curr.get(instance).cast<int>(), 42);
+        }
+
+        ASSERT_EQ(instance.base, 42);
+        ASSERT_EQ(instance.left, 42);
+        ASSERT_EQ(instance.right, 42);
+        ASSERT_EQ(instance.value, 42);
+    };
+
+    check();
+    meta::freeze(ctx);
+    check();
+}
+
+TEST_F(Meta, AnyHash) {
+    data_type instance{};
+    data_type other{};
+    setter_getter_type sg{};
+    concrete_type concrete{};
+
+    ASSERT_EQ(meta::any{}.hash(), 0u);
+    ASSERT_EQ(meta::any{42}.hash(), std::hash<int>{}(42));
+    ASSERT_EQ(meta::any{std::string{"foo"}}.hash(), std::hash<std::string>{}("foo"));
+
+    // reflected types are hashed member by member, static members aren't part of the hash
+    ASSERT_EQ(meta::any{instance}.hash(), meta::any{other}.hash());
+
+    data_type::h = 42;
+
+    ASSERT_EQ(meta::any{instance}.hash(), meta::any{other}.hash());
+
+    other.v = 42;
+
+    ASSERT_NE(meta::any{instance}.hash(), meta::any{other}.hash());
+
+    const auto hash = meta::any{sg}.hash();
+    sg.setter(42);
+
+    ASSERT_NE(meta::any{sg}.hash(), hash);
+
+    const auto base = meta::any{concrete}.hash();
+    concrete.h('c');
+
+    ASSERT_NE(meta::any{concrete}.hash(), base);
+    ASSERT_EQ(meta::any{concrete_type{}}.hash(), base);
+
+    meta::reflect<cached_type>("cached"_hs)
+            .data<&cached_type::value>("value"_hs);
+
+    cached_type lhs{42, 0};
+    cached_type rhs{42, 1};
+
+    // comparable types are hashed member by member as well, unregistered members aren't part of the hash
+    ASSERT_EQ(meta::any{lhs}, meta::any{rhs});
+    ASSERT_EQ(meta::any{lhs}.hash(), meta::any{rhs}.hash());
+
+    rhs.value = 3;
+
+    ASSERT_NE(meta::any{lhs}, meta::any{rhs});
+    ASSERT_NE(meta::any{lhs}.hash(), meta::any{rhs}.hash());
+
+    std::unordered_set<meta::any> set{};
+    set.insert(42);
+    set.insert(42);
+    set.insert(std::string{"foo"});
+    set.insert(std::string{"foo"});
+
+    ASSERT_EQ(set.size(), 2u);
+    ASSERT_NE(set.find(std::string{"foo"}), set.cend());
+    ASSERT_EQ(set.find(3), set.cend());
+}
+
+
 TEST_F(Meta, Unregister) {
     std::hash<std::string_view> hash{};
 
@@ -0,0 +1,323 @@
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+#include <meta/factory.hpp>
+#include <meta/hashed_string.hpp>
+#include <meta/meta.hpp>
+#include <meta/serializer.hpp>
+#include "common/types.hpp"
+
+struct serializer_derived_type: common_base_type, common_accessor_type {
+    common_pod_type pod;
+    std::string name;
+    const int constant{3};
+};
+
+
+struct serializer_invalid_type {
+    std::string name;
+};
+
+
+struct serializer_pointer_type {
+    int value;
+    const int *ptr;
+};
+
+
+struct serializer_view_type {
+    int value;
+    std::string_view view;
+};
+
+
+template<typename Type>
+Type read(const std::byte *&data) {
+    Type value;
+    std::memcpy(&value, data, sizeof(Type));
+    data += sizeof(Type);
+    return value;
+}
+
+
+struct serializer_other_type {
+    double d;
+    int i;
+    long extra;
+};
+
+
+constexpr std::size_t header(const std::size_t fields) {
+    // schema hash, number of members and their descriptions
+    return sizeof(std::size_t) * (2u + 3u * fields);
+}
+
+
+struct Serializer: ::testing::Test {
+    static void SetUpTestCase() {
+        reflect_common_types();
+
+        meta::reflect<serializer_derived_type>("serializer_derived"_hs)
+                .base<common_base_type>()
+                .ctor<>()
+                .data<&serializer_derived_type::pod>("pod"_hs)
+                .data<&serializer_derived_type::constant>("constant"_hs)
+                .data<&serializer_derived_type::set, &serializer_derived_type::get>("value"_hs);
+
+        meta::reflect<serializer_invalid_type>("serializer_invalid"_hs)
+                .data<&serializer_invalid_type::name>("name"_hs);
+
+        meta::reflect<serializer_pointer_type>("serializer_pointer"_hs)
+                .data<&serializer_pointer_type::value>("value"_hs)
+                .data<&serializer_pointer_type::ptr>("ptr"_hs);
+
+        meta::reflect<serializer_view_type>("serializer_view"_hs)
+                .data<&serializer_view_type::value>("value"_hs)
+                .data<&serializer_view_type::view>("view"_hs);
+
+        meta::reflect<serializer_other_type>("serializer_other"_hs)
+                .data<&serializer_other_type::extra>("extra"_hs)
+                .data<&serializer_other_type::i>("i"_hs)
+                .data<&serializer_other_type::d>("d"_hs);
+    }
+};
+
+
+TEST_F(Serializer, Trivial) {
+    meta::serializer serializer{};
+    int value = 42;
+
+    ASSERT_TRUE(serializer.write(value));
+    ASSERT_EQ(serializer.size(), header(0u) + sizeof(int));
+
+    const auto *data = serializer.data() + header(0u);
+
+    ASSERT_EQ(read<int>(data), 42);
+
+    ASSERT_TRUE(serializer.write(value));
+    ASSERT_EQ(serializer.size(), header(0u) + sizeof(std::size_t) + 2u * sizeof(int));
+}
+
+
+TEST_F(Serializer, Runs) {
+    meta::serializer serializer{};
+    common_pod_type instance{1, 'c', .5};
+
+    // trivially copyable types are copied as a whole, paddings are described as unnamed members
+    ASSERT_TRUE(serializer.write(instance));
+    ASSERT_TRUE(serializer.write(instance));
+    ASSERT_EQ(serializer.size(), header(4u) + sizeof(std::size_t) + 2u * sizeof(common_pod_type));
+
+    const auto *data = serializer.data();
+
+    for(auto i = 0; i < 2; ++i) {
+        data += i ? sizeof(std::size_t) : header(4u);
+        const auto other = read<common_pod_type>(data);
+
+        ASSERT_EQ(other.i, 1);
+        ASSERT_EQ(other.c, 'c');
+        ASSERT_EQ(other.d, .5);
+    }
+
+    serializer.clear();
+
+    ASSERT_EQ(serializer.size(), 0u);
+}
+
+
+TEST_F(Serializer, Hierarchy) {
+    meta::serializer serializer{};
+    serializer_derived_type instance{};
+
+    instance.base = 3;
+    instance.pod = {4, 'x', 1.5};
+    instance.set(5);
+
+    ASSERT_TRUE(serializer.write(instance));
+    ASSERT_EQ(serializer.size(), header(3u) + sizeof(common_pod_type) + sizeof(int) + sizeof(int));
+
+    const auto *data = serializer.data() + header(3u);
+    const auto pod = read<common_pod_type>(data);
+
+    ASSERT_EQ(pod.i, 4);
+    ASSERT_EQ(pod.c, 'x');
+    ASSERT_EQ(pod.d, 1.5);
+    ASSERT_EQ(read<int>(data), 5);
+    ASSERT_EQ(read<int>(data), 3);
+}
+
+
+TEST_F(Serializer, Any) {
+    meta::serializer serializer{};
+    meta::any any{common_pod_type{2, 'a', 0.}};
+
+    ASSERT_TRUE(serializer.write(any));
+    ASSERT_EQ(serializer.size(), header(4u) + sizeof(common_pod_type));
+}
+
+
+TEST_F(Serializer, Invalid) {
+    meta::serializer serializer{};
+    serializer_invalid_type instance{"foo"};
+    std::string str{};
+    int value = 42;
+
+    ASSERT_TRUE(serializer.write(value));
+    ASSERT_FALSE(serializer.write(instance));
+    ASSERT_FALSE(serializer.write(str));
+    ASSERT_FALSE(serializer.write(meta::handle{}));
+    ASSERT_EQ(serializer.size(), header(0u) + sizeof(int));
+}
+
+
+TEST_F(Serializer, Addresses) {
+    meta::serializer serializer{};
+    serializer_pointer_type pointer{42, nullptr};
+    serializer_view_type view{42, "foo"};
+    const int *ptr = &pointer.value;
+
+    // addresses would dangle once read back, they aren't copied as they are
+    ASSERT_FALSE(serializer.write(pointer));
+    ASSERT_FALSE(serializer.write(view));
+    ASSERT_FALSE(serializer.write(ptr));
+    ASSERT_EQ(serializer.size(), 0u);
+}
+
+
+TEST_F(Serializer, ReadInPlace) {
+    meta::serializer serializer{};
+    common_pod_type instance{1, 'c', .5};
+    common_pod_type other{};
+    int value = 42;
+
+    ASSERT_TRUE(serializer.write(instance));
+    ASSERT_TRUE(serializer.write(value));
+
+    meta::deserializer deserializer{serializer.data(), serializer.size()};
+    value = 0;
+
+    ASSERT_TRUE(deserializer.read(other));
+    ASSERT_FALSE(deserializer.read(other));
+    ASSERT_TRUE(deserializer.read(value));
+    ASSERT_EQ(deserializer.size(), 0u);
+    ASSERT_FALSE(deserializer.read(value));
+
+    ASSERT_EQ(other.i, 1);
+    ASSERT_EQ(other.c, 'c');
+    ASSERT_EQ(other.d, .5);
+    ASSERT_EQ(value, 42);
+}
+
+
+TEST_F(Serializer, ReadConstruct) {
+    meta::serializer serializer{};
+    serializer_derived_type instance{};
+
+    instance.base = 3;
+    instance.pod = {4, 'x', 1.5};
+    instance.set(5);
+
+    ASSERT_TRUE(serializer.write(instance));
+
+    meta::deserializer deserializer{serializer.data(), serializer.size()};
+    auto any = deserializer.read(meta::resolve<serializer_derived_type>());
+
+    ASSERT_TRUE(any);
+    ASSERT_EQ(deserializer.size(), 0u);
+
+    const auto &other = any.cast<serializer_derived_type>();
+
+    ASSERT_EQ(other.base, 3);
+    ASSERT_EQ(other.pod.i, 4);
+    ASSERT_EQ(other.pod.c, 'x');
+    ASSERT_EQ(other.pod.d, 1.5);
+    ASSERT_EQ(other.get(), 5);
+    ASSERT_EQ(other.value, 10);
+
+    ASSERT_FALSE(deserializer.read(meta::resolve<serializer_derived_type>()));
+
+    meta::deserializer other_deserializer{serializer.data(), serializer.size()};
+
+    ASSERT_FALSE(other_deserializer.read(meta::resolve<common_pod_type>()));
+    ASSERT_EQ(other_deserializer.size(), serializer.size());
+}
+
+
+TEST_F(Serializer, ReadHandWritten) {
+    meta::serializer serializer{};
+    std::vector<common_pod_type> instances{};
+
+    for(auto i = 0; i < 16; ++i) {
+        instances.push_back({i, static_cast<char>('a' + i), i * .5});
+        ASSERT_TRUE(serializer.write(instances.back()));
+    }
+
+    // the output must be the same as that of a hand-written decoder
+    meta::deserializer deserializer{serializer.data(), serializer.size()};
+    const auto *data = serializer.data();
+
+    for(auto &&instance: instances) {
+        common_pod_type other{};
+        data += (&instance == instances.data()) ? header(4u) : sizeof(std::size_t);
+        const auto expected = read<common_pod_type>(data);
+
+        ASSERT_TRUE(deserializer.read(other));
+        ASSERT_EQ(other.i, expected.i);
+        ASSERT_EQ(other.c, expected.c);
+        ASSERT_EQ(other.d, expected.d);
+        ASSERT_EQ(other.i, instance.i);
+    }
+
+    ASSERT_EQ(deserializer.size(), 0u);
+}
+
+
+TEST_F(Serializer, SchemaHash) {
+    const auto pod = meta::resolve<common_pod_type>().schema_hash();
+
+    ASSERT_EQ(pod, meta::resolve<common_pod_type>().schema_hash());
+    ASSERT_NE(pod, meta::resolve<serializer_other_type>().schema_hash());
+    ASSERT_NE(pod, meta::resolve<serializer_derived_type>().schema_hash());
+    ASSERT_NE(meta::resolve<int>().schema_hash(), meta::resolve<float>().schema_hash());
+
+    struct local_type { int i; int j; };
+
+    meta::reflect<local_type>("serializer_local"_hs).data<&local_type::i>("i"_hs);
+    const auto partial = meta::resolve<local_type>().schema_hash();
+
+    // cached fingerprints follow the registration of new members
+    meta::reflect<local_type>().data<&local_type::j>("j"_hs);
+
+    ASSERT_NE(partial, meta::resolve<local_type>().schema_hash());
+    ASSERT_EQ(meta::resolve<local_type>().schema_hash(), meta::resolve<local_type>().schema_hash());
+    ASSERT_TRUE(meta::unregister<local_type>());
+}
+
+
+TEST_F(Serializer, SchemaMismatch) {
+    meta::serializer serializer{};
+    common_pod_type instance{1, 'c', .5};
+
+    ASSERT_TRUE(serializer.write(instance));
+    ASSERT_TRUE(serializer.write(instance));
+
+    // members are matched by identifier, those that are missing are skipped
+    meta::deserializer deserializer{serializer.data(), serializer.size()};
+    serializer_other_type other{0., 0, 42l};
+
+    ASSERT_TRUE(deserializer.read(other));
+
+    ASSERT_EQ(other.d, .5);
+    ASSERT_EQ(other.i, 1);
+    ASSERT_EQ(other.extra, 42l);
+
+    other = {};
+
+    ASSERT_TRUE(deserializer.read(other));
+    ASSERT_EQ(other.d, .5);
+    ASSERT_EQ(other.i, 1);
+    ASSERT_EQ(deserializer.size(), 0u);
+}